@@ -6,7 +6,7 @@ public class ElectiveX : ModuleRules
 {
 	public ElectiveX(ReadOnlyTargetRules Target) : base(Target)
 	{
-		PrivateDependencyModuleNames.AddRange(new string[] { "AIModule" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "AIModule", "MassEntity", "MassCommon", "MassMovement", "MassSpawner", "StructUtils", "Chaos", "ChaosSolverEngine", "GeometryCollectionEngine", "Niagara", "TimeRewindCore" });
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
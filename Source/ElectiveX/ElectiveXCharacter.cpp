@@ -9,6 +9,8 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "TimeRewindComponent.h"
+#include "MassTimeRewindSubsystem.h"
+#include "NiagaraRewindSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/LocalPlayer.h"
 
@@ -43,6 +45,11 @@ void AElectiveXCharacter::BeginPlay()
 {
 	// Call the base class  
 	Super::BeginPlay();
+
+	if (UMassTimeRewindSubsystem* MassRewindSubsystem = GetWorld()->GetSubsystem<UMassTimeRewindSubsystem>())
+	{
+		MassRewindSubsystem->OnRewindStarted.AddUObject(this, &AElectiveXCharacter::OnMassRewindStarted);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////// Input
@@ -143,16 +150,46 @@ void AElectiveXCharacter::Rewind()
 		}
 	}
 
+	// Mass entities pick the request up on the next processing pass, OnMassRewindStarted reports the count
+	if (UMassTimeRewindSubsystem* MassRewindSubsystem = World->GetSubsystem<UMassTimeRewindSubsystem>())
+	{
+		PendingMassRewindRequest = MassRewindSubsystem->StartTimeRewind(PlayerLocation, RewindRadius);
+	}
+
+	if (UNiagaraRewindSubsystem* NiagaraRewindSubsystem = World->GetSubsystem<UNiagaraRewindSubsystem>())
+	{
+		RewindedActorsCount += NiagaraRewindSubsystem->StartTimeRewind(PlayerLocation, RewindRadius);
+	}
+
 	if (RewindedActorsCount > 0)
 	{
-		GetWorld()->GetTimerManager().SetTimer(
-			RewindCooldownTimerHandle, 
-			RewindCooldownDuration, 
-			false  // Does not loop
-		);
-
-		// maybe add any additional effects
-		OnRewindSuccessful();
+		StartRewindCooldown();
+	}
+}
+
+void AElectiveXCharacter::StartRewindCooldown()
+{
+	GetWorld()->GetTimerManager().SetTimer(
+		RewindCooldownTimerHandle, 
+		RewindCooldownDuration, 
+		false  // Does not loop
+	);
+
+	// maybe add any additional effects
+	OnRewindSuccessful();
+}
+
+void AElectiveXCharacter::OnMassRewindStarted(int32 RequestId, int32 NumEntities)
+{
+	if (RequestId != PendingMassRewindRequest)
+		return;
+
+	PendingMassRewindRequest = INDEX_NONE;
+
+	// Actors or effects may already have started the cooldown for this Rewind()
+	if (NumEntities > 0 && !GetWorld()->GetTimerManager().IsTimerActive(RewindCooldownTimerHandle))
+	{
+		StartRewindCooldown();
 	}
 }
 
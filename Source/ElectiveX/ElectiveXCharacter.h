@@ -70,6 +70,13 @@ protected:
 
 	void Rewind();
 
+	void StartRewindCooldown();
+
+	// Mass resolves a request on its next record pass, a frame after Rewind()
+	void OnMassRewindStarted(int32 RequestId, int32 NumEntities);
+
+	int32 PendingMassRewindRequest = INDEX_NONE;
+
 protected:
 	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
 
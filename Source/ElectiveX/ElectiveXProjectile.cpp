@@ -3,6 +3,8 @@
 #include "ElectiveXProjectile.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
+#include "NiagaraRewindSubsystem.h"
+#include "TimeRewindReplaySubsystem.h"
 
 AElectiveXProjectile::AElectiveXProjectile() 
 {
@@ -33,11 +35,27 @@ AElectiveXProjectile::AElectiveXProjectile()
 
 void AElectiveXProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	if (ImpactEffect != nullptr && OtherActor != this)
+	{
+		if (UNiagaraRewindSubsystem* RewindSubsystem = GetWorld()->GetSubsystem<UNiagaraRewindSubsystem>())
+		{
+			RewindSubsystem->SpawnRewindableSystem(ImpactEffect, Hit.ImpactPoint, Hit.ImpactNormal.Rotation(), ImpactEffectParameters);
+		}
+	}
+
 	// Only add impulse and destroy projectile if we hit a physics
 	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
 	{
 		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
 
+		if (ReplayViewer.IsValid())
+		{
+			if (UTimeRewindReplaySubsystem* ReplaySubsystem = GetWorld()->GetSubsystem<UTimeRewindReplaySubsystem>())
+			{
+				ReplaySubsystem->RequestReplay(OtherActor, ReplayViewer.Get());
+			}
+		}
+
 		Destroy();
 	}
 }
\ No newline at end of file
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "NiagaraRewindSubsystem.h"
 #include "ElectiveXProjectile.generated.h"
 
 class USphereComponent;
 class UProjectileMovementComponent;
+class UNiagaraSystem;
+class APlayerController;
 
 UCLASS(config=Game)
 class AElectiveXProjectile : public AActor
@@ -22,6 +25,17 @@ class AElectiveXProjectile : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	UProjectileMovementComponent* ProjectileMovement;
 
+	/** Effect spawned where the projectile hits, rewound by seed instead of being recorded */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	UNiagaraSystem* ImpactEffect;
+
+	/** User parameters ImpactEffect is spawned with, kept with the effect so rewinds replay it the same */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	FNiagaraRewindParameters ImpactEffectParameters;
+
+	/** Player shown the replay of what this projectile hits, unset when the weapon does not replay */
+	TWeakObjectPtr<APlayerController> ReplayViewer;
+
 public:
 	AElectiveXProjectile();
 
@@ -29,6 +43,9 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/** Shows this player an instant replay when the projectile knocks a physics object away */
+	void SetReplayViewer(APlayerController* Viewer) { ReplayViewer = Viewer; }
+
 	/** Returns CollisionComp subobject **/
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
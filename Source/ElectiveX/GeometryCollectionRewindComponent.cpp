@@ -0,0 +1,309 @@
+#include "GeometryCollectionRewindComponent.h"
+#include "TimeRewindComponent.h"
+#include "GameFramework/Actor.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "TimeRewindCompression.h"
+
+namespace
+{
+    void PackRotation(const FQuat& Rotation, int16 OutPacked[4])
+    {
+        const float Components[4] = { (float)Rotation.X, (float)Rotation.Y, (float)Rotation.Z, (float)Rotation.W };
+        TimeRewindCore::PackQuaternion(Components, OutPacked);
+    }
+
+    FQuat UnpackRotation(const int16 Packed[4])
+    {
+        float Components[4];
+        TimeRewindCore::UnpackQuaternion(Packed, Components);
+        return FQuat(Components[0], Components[1], Components[2], Components[3]);
+    }
+
+    FTransform UnpackSample(const FGeometryCollectionPieceSample& Sample)
+    {
+        return FTransform(UnpackRotation(Sample.Rotation), FVector(Sample.Location));
+    }
+
+    FTransform SamplePieceTrack(const FGeometryCollectionPieceTrack& Track, double TargetTime)
+    {
+        FGeometryCollectionPieceTrack::FBracket Bracket;
+        Track.FindBracket(TargetTime, Bracket);
+        if (Bracket.IsClamped())
+        {
+            return UnpackSample(Track.At(Bracket.From));
+        }
+
+        const FGeometryCollectionPieceSample& From = Track.At(Bracket.From);
+        const FGeometryCollectionPieceSample& To = Track.At(Bracket.To);
+        const float Alpha = Bracket.Alpha;
+        return FTransform(
+            FQuat::Slerp(UnpackRotation(From.Rotation), UnpackRotation(To.Rotation), Alpha),
+            FVector(FMath::Lerp(From.Location, To.Location, Alpha)));
+    }
+}
+
+UGeometryCollectionRewindComponent::UGeometryCollectionRewindComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UGeometryCollectionRewindComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    AActor* Owner = GetOwner();
+    GeometryCollection = Owner ? Owner->FindComponentByClass<UGeometryCollectionComponent>() : nullptr;
+    if (!GeometryCollection)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GeometryCollectionRewindComponent: No geometry collection on owner"));
+        SetComponentTickEnabled(false);
+        return;
+    }
+
+    // Rewind timing follows the actor's own rewind component
+    RewindComponent = Owner->FindComponentByClass<UTimeRewindComponent>();
+    if (!RewindComponent)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GeometryCollectionRewindComponent: Owner has no TimeRewindComponent to follow"));
+        SetComponentTickEnabled(false);
+        return;
+    }
+    RewindComponent->OnRewindStart.AddDynamic(this, &UGeometryCollectionRewindComponent::OnRewindStart);
+    RewindComponent->OnRewindStop.AddDynamic(this, &UGeometryCollectionRewindComponent::OnRewindStop);
+
+    GeometryCollection->SetNotifyBreaks(true);
+    GeometryCollection->OnChaosBreakEvent.AddDynamic(this, &UGeometryCollectionRewindComponent::OnPieceBreak);
+
+    for (const auto& PieceTransform : GeometryCollection->GetComponentSpaceTransforms())
+    {
+        IntactTransforms.Add(FTransform(PieceTransform));
+    }
+    PieceTracks.SetNum(IntactTransforms.Num());
+}
+
+void UGeometryCollectionRewindComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!bIsRewinding)
+    {
+        RecordTimer += DeltaTime;
+        if (RecordTimer >= RecordInterval)
+        {
+            RecordPieces();
+            RecordTimer = 0.0f;
+        }
+        return;
+    }
+
+    // Stopping is driven by the TimeRewindComponent, just hold the last pose until then
+    RewindProgress = FMath::Min(RewindProgress + DeltaTime / RewindComponent->RewindDuration, 1.0f);
+    const double TargetTime = RewindStartTime - (RewindProgress * RewindComponent->RewindHistoryDuration);
+
+    if (bRestoredIntact)
+        return;
+
+    if (Breaks.Num() > 0 && TargetTime < Breaks[0].Timestamp)
+    {
+        RestoreIntact();
+    }
+    else
+    {
+        ApplyPiecesAtTime(TargetTime);
+    }
+}
+
+void UGeometryCollectionRewindComponent::OnPieceBreak(const FChaosBreakEvent& BreakEvent)
+{
+    if (bIsRewinding)
+        return;
+
+    // Crumbling replayed breaks after a rewind reports them again, a piece only comes loose once per timeline
+    if (Breaks.ContainsByPredicate([&BreakEvent](const FGeometryCollectionBreakRecord& Break) { return Break.PieceIndex == BreakEvent.Index; }))
+        return;
+
+    Breaks.Add({ GetWorld()->GetTimeSeconds(), BreakEvent.Index });
+}
+
+void UGeometryCollectionRewindComponent::RecordPieces()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    const auto& ComponentSpaceTransforms = GeometryCollection->GetComponentSpaceTransforms();
+    const int32 NumPieces = FMath::Min(ComponentSpaceTransforms.Num(), PieceTracks.Num());
+    const float ToleranceSquared = FMath::Square(PieceMoveTolerance);
+
+    for (int32 PieceIndex = 0; PieceIndex < NumPieces; ++PieceIndex)
+    {
+        const FTransform PieceTransform(ComponentSpaceTransforms[PieceIndex]);
+        FGeometryCollectionPieceTrack& Track = PieceTracks[PieceIndex];
+
+        // Only pieces that moved since their last sample are active and get recorded
+        const FTransform Reference = Track.Num() > 0 ? UnpackSample(Track.At(Track.Num() - 1)) : IntactTransforms[PieceIndex];
+        if (FVector::DistSquared(PieceTransform.GetLocation(), Reference.GetLocation()) <= ToleranceSquared
+            && PieceTransform.GetRotation().Equals(Reference.GetRotation(), 1.e-3f))
+        {
+            continue;
+        }
+
+        // A piece starting to move held its last pose until the previous record, key that first so
+        // playback does not interpolate across the idle period or pull the first move back in time
+        const bool bWasIdle = Track.Num() == 0 || Track.TimeAt(Track.Num() - 1) < LastRecordTime;
+        if (bWasIdle && LastRecordTime > 0.0)
+        {
+            FGeometryCollectionPieceSample& HoldSample = Track.Append(LastRecordTime);
+            HoldSample.Location = FVector3f(Reference.GetLocation());
+            PackRotation(Reference.GetRotation(), HoldSample.Rotation);
+        }
+
+        FGeometryCollectionPieceSample& Sample = Track.Append(Now);
+        Sample.Location = FVector3f(PieceTransform.GetLocation());
+        PackRotation(PieceTransform.GetRotation(), Sample.Rotation);
+    }
+
+    LastRecordTime = Now;
+    TrimHistory(Now - RewindComponent->MaxHistoryDuration);
+}
+
+void UGeometryCollectionRewindComponent::TrimHistory(double OldestTime)
+{
+    // Breaks are never trimmed: there is at most one per piece, and playback restores the intact
+    // collection before the first of them, which has to stay the first one that really happened
+    for (FGeometryCollectionPieceTrack& Track : PieceTracks)
+    {
+        // Keeps the last sample before the window so the piece still has a pose to rewind to
+        Track.TrimBefore(OldestTime);
+    }
+}
+
+void UGeometryCollectionRewindComponent::ApplyPiecesAtTime(double TargetTime)
+{
+    TArray<FTransform> ComponentSpace = IntactTransforms;
+    for (int32 PieceIndex = 0; PieceIndex < PieceTracks.Num(); ++PieceIndex)
+    {
+        if (PieceTracks[PieceIndex].Num() > 0)
+        {
+            ComponentSpace[PieceIndex] = SamplePieceTrack(PieceTracks[PieceIndex], TargetTime);
+        }
+    }
+
+    // Pieces that had not come loose yet at TargetTime sit where they do in the intact collection
+    for (int32 BreakIndex = Breaks.Num() - 1; BreakIndex >= 0 && Breaks[BreakIndex].Timestamp > TargetTime; --BreakIndex)
+    {
+        const int32 PieceIndex = Breaks[BreakIndex].PieceIndex;
+        if (ComponentSpace.IsValidIndex(PieceIndex))
+        {
+            ComponentSpace[PieceIndex] = IntactTransforms[PieceIndex];
+        }
+    }
+
+    // The rest state is stored relative to each piece's parent in the cluster hierarchy
+    const TManagedArray<int32>& Parents = GeometryCollection->GetParentArray();
+    TArray<FTransform> LocalTransforms;
+    LocalTransforms.SetNumUninitialized(ComponentSpace.Num());
+    for (int32 PieceIndex = 0; PieceIndex < ComponentSpace.Num(); ++PieceIndex)
+    {
+        const int32 Parent = Parents[PieceIndex];
+        LocalTransforms[PieceIndex] = Parent == INDEX_NONE
+            ? ComponentSpace[PieceIndex]
+            : ComponentSpace[PieceIndex].GetRelativeTransform(ComponentSpace[Parent]);
+    }
+
+    GeometryCollection->SetRestState(MoveTemp(LocalTransforms));
+}
+
+void UGeometryCollectionRewindComponent::RestoreIntact()
+{
+    // Tracks are dropped first so the applied pose is exactly the intact one
+    for (FGeometryCollectionPieceTrack& Track : PieceTracks)
+    {
+        Track.Reset();
+    }
+    Breaks.Reset();
+
+    ApplyPiecesAtTime(0.0);
+    bRestoredIntact = true;
+}
+
+void UGeometryCollectionRewindComponent::OnRewindStart()
+{
+    bIsRewinding = true;
+    bRestoredIntact = false;
+    RewindProgress = 0.0f;
+    RewindStartTime = GetWorld()->GetTimeSeconds();
+
+    // Playback drives the pieces through the rest state, keep the solver out of the way
+    bWasSimulatingPhysics = GeometryCollection->BodyInstance.bSimulatePhysics;
+    GeometryCollection->SetSimulatePhysics(false);
+}
+
+void UGeometryCollectionRewindComponent::ReapplyBreaks(double UpToTime)
+{
+    // A break record names the piece that came loose, crumbling its parent releases it again. Records
+    // are in break order, so outer clusters are released before the nested ones inside them.
+    const TManagedArray<int32>& Parents = GeometryCollection->GetParentArray();
+    TSet<int32> Crumbled;
+    for (const FGeometryCollectionBreakRecord& Break : Breaks)
+    {
+        if (Break.Timestamp > UpToTime)
+            break;
+
+        const int32 Parent = Break.PieceIndex < Parents.Num() ? Parents[Break.PieceIndex] : INDEX_NONE;
+        if (Parent != INDEX_NONE && !Crumbled.Contains(Parent))
+        {
+            Crumbled.Add(Parent);
+            GeometryCollection->CrumbleCluster(Parent);
+        }
+    }
+}
+
+void UGeometryCollectionRewindComponent::OnRewindStop()
+{
+    bIsRewinding = false;
+    RecordTimer = 0.0f;
+
+    GeometryCollection->SetSimulatePhysics(bWasSimulatingPhysics);
+
+    // The actor lands on its nearest recorded state rather than where playback stopped, move the
+    // pieces there too so both histories branch at the same time
+    const double BranchTime = RewindComponent->GetLandingTime();
+    if (!bRestoredIntact)
+    {
+        if (Breaks.Num() > 0 && BranchTime < Breaks[0].Timestamp)
+        {
+            RestoreIntact();
+        }
+        else
+        {
+            ApplyPiecesAtTime(BranchTime);
+        }
+    }
+
+    // Rebuilding the physics state moves every particle to the rest state playback wrote, as one
+    // unbroken cluster; breaks from before the landing point are then replayed so the loose pieces
+    // carry on from their rewound poses instead of popping back to where the solver left them
+    GeometryCollection->RecreatePhysicsState();
+    if (!bRestoredIntact)
+    {
+        ReapplyBreaks(BranchTime);
+    }
+
+    // RestoreIntact already dropped everything, the history before the first break holds no piece motion
+    BranchHistory(BranchTime, GetWorld()->GetTimeSeconds());
+    LastRecordTime = GetWorld()->GetTimeSeconds();
+}
+
+void UGeometryCollectionRewindComponent::BranchHistory(double BranchTime, double Now)
+{
+    // Same as UTimeRewindComponent::StopTimeRewind, keep the past up to where the rewind landed so a
+    // second rewind can go further back, shifted so the landing point lines up with now
+    for (FGeometryCollectionPieceTrack& Track : PieceTracks)
+    {
+        Track.Branch(BranchTime, Now);
+    }
+
+    Breaks.RemoveAll([BranchTime](const FGeometryCollectionBreakRecord& Break) { return Break.Timestamp > BranchTime; });
+    for (FGeometryCollectionBreakRecord& Break : Breaks)
+    {
+        Break.Timestamp += Now - BranchTime;
+    }
+}
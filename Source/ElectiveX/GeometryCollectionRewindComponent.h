@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TimeRewindHistory.h"
+#include "GeometryCollectionRewindComponent.generated.h"
+
+class UGeometryCollectionComponent;
+class UTimeRewindComponent;
+struct FChaosBreakEvent;
+
+// One recorded transform of a fractured piece, component space, rotation packed to 16 bits per axis
+struct FGeometryCollectionPieceSample
+{
+    FVector3f Location;
+    int16 Rotation[4];
+    // Seconds after the base time of the chunk holding the sample
+    float Time;
+};
+static_assert(sizeof(FGeometryCollectionPieceSample) == 24, "Piece samples are recorded for every moving piece, keep them small");
+
+// Samples of a single piece, only filled once the piece starts moving
+using FGeometryCollectionPieceTrack = TimeRewindCore::TChunkedHistory<FGeometryCollectionPieceSample, 16>;
+
+struct FGeometryCollectionBreakRecord
+{
+    double Timestamp;
+    int32 PieceIndex;
+};
+
+// Rewind channel for a Chaos geometry collection on the same actor. Follows the actor's
+// UTimeRewindComponent: records break events plus the transforms of pieces that are moving,
+// plays them back during rewind and re-clusters the collection once playback passes the first break.
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class ELECTIVEX_API UGeometryCollectionRewindComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UGeometryCollectionRewindComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    float RecordInterval = 0.05f;
+
+    // Pieces that moved less than this since their last sample are not recorded
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    float PieceMoveTolerance = 0.1f;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+    UFUNCTION()
+    void OnPieceBreak(const FChaosBreakEvent& BreakEvent);
+
+    UFUNCTION()
+    void OnRewindStart();
+
+    UFUNCTION()
+    void OnRewindStop();
+
+    void RecordPieces();
+    void TrimHistory(double OldestTime);
+    void ApplyPiecesAtTime(double TargetTime);
+    void RestoreIntact();
+    void ReapplyBreaks(double UpToTime);
+    void BranchHistory(double BranchTime, double Now);
+
+    UPROPERTY()
+    UGeometryCollectionComponent* GeometryCollection = nullptr;
+
+    // History depth and rewind timing come from here so both histories branch at the same point
+    UPROPERTY()
+    UTimeRewindComponent* RewindComponent = nullptr;
+
+    // Piece transforms of the intact collection, captured before anything can break
+    TArray<FTransform> IntactTransforms;
+    TArray<FGeometryCollectionPieceTrack> PieceTracks;
+    TArray<FGeometryCollectionBreakRecord> Breaks;
+
+    float RecordTimer = 0.0f;
+    // World time of the last RecordPieces, idle pieces held their pose up to it
+    double LastRecordTime = 0.0;
+    bool bIsRewinding = false;
+    bool bRestoredIntact = false;
+    bool bWasSimulatingPhysics = true;
+    float RewindProgress = 0.0f;
+    double RewindStartTime = 0.0;
+};
@@ -0,0 +1,143 @@
+#include "MassTimeRewindProcessors.h"
+#include "MassTimeRewindTypes.h"
+#include "MassTimeRewindSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "MassMovementFragments.h"
+
+UMassTimeRewindRecordProcessor::UMassTimeRewindRecordProcessor()
+{
+    // Takes requests queued by gameplay code and reports back to it through the subsystem's delegate
+    bRequiresGameThreadExecution = true;
+    ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+    ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+}
+
+void UMassTimeRewindRecordProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FMassTimeRewindHistoryFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FMassTimeRewindPlaybackFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddConstSharedRequirement<FMassTimeRewindSettingsFragment>();
+    EntityQuery.AddTagRequirement<FMassTimeRewindingTag>(EMassFragmentPresence::None);
+    EntityQuery.RegisterWithProcessor(*this);
+
+    ProcessorRequirements.AddSubsystemRequirement<UMassTimeRewindSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+void UMassTimeRewindRecordProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    if (!World)
+        return;
+
+    UMassTimeRewindSubsystem& RewindSubsystem = Context.GetMutableSubsystemChecked<UMassTimeRewindSubsystem>();
+    const TArray<FMassTimeRewindRequest> Requests = RewindSubsystem.ConsumeRewindRequests();
+    TArray<int32> NumEntitiesPerRequest;
+    NumEntitiesPerRequest.SetNumZeroed(Requests.Num());
+
+    const double Now = World->GetTimeSeconds();
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [&Requests, &NumEntitiesPerRequest, Now](FMassExecutionContext& Context)
+    {
+        const FMassTimeRewindSettingsFragment& Settings = Context.GetConstSharedFragment<FMassTimeRewindSettingsFragment>();
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        const TArrayView<FMassTimeRewindHistoryFragment> Histories = Context.GetMutableFragmentView<FMassTimeRewindHistoryFragment>();
+        const TArrayView<FMassTimeRewindPlaybackFragment> Playbacks = Context.GetMutableFragmentView<FMassTimeRewindPlaybackFragment>();
+        const int32 MaxHistoryStates = Settings.GetMaxHistoryStates();
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+        for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            FMassTimeRewindHistoryFragment& History = Histories[EntityIndex];
+            const FTransform& Transform = Transforms[EntityIndex].GetTransform();
+
+            const int32 RequestIndex = History.Num() > 0 ? Requests.IndexOfByPredicate([&Transform](const FMassTimeRewindRequest& Request)
+            {
+                return FVector::DistSquared(Transform.GetLocation(), Request.Origin) <= FMath::Square(Request.Radius);
+            }) : INDEX_NONE;
+
+            if (RequestIndex != INDEX_NONE)
+            {
+                ++NumEntitiesPerRequest[RequestIndex];
+                FMassTimeRewindPlaybackFragment& Playback = Playbacks[EntityIndex];
+                Playback.RewindStartTime = Now;
+                Playback.RewindProgress = 0.0f;
+                Context.Defer().AddTag<FMassTimeRewindingTag>(Context.GetEntity(EntityIndex));
+                continue;
+            }
+
+            History.RecordTimer += DeltaTime;
+            if (History.RecordTimer < Settings.RecordInterval)
+                continue;
+
+            History.RecordTimer = 0.0f;
+            History.Record(Now, Transform, MaxHistoryStates);
+        }
+    });
+
+    RewindSubsystem.ResolveRewindRequests(Requests, NumEntitiesPerRequest);
+}
+
+UMassTimeRewindPlaybackProcessor::UMassTimeRewindPlaybackProcessor()
+{
+    ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+    ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+}
+
+void UMassTimeRewindPlaybackProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+    EntityQuery.AddRequirement<FMassTimeRewindHistoryFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FMassTimeRewindPlaybackFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddConstSharedRequirement<FMassTimeRewindSettingsFragment>();
+    EntityQuery.AddTagRequirement<FMassTimeRewindingTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UMassTimeRewindPlaybackProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    if (!World)
+        return;
+
+    const double Now = World->GetTimeSeconds();
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [Now](FMassExecutionContext& Context)
+    {
+        const FMassTimeRewindSettingsFragment& Settings = Context.GetConstSharedFragment<FMassTimeRewindSettingsFragment>();
+        const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+        const TArrayView<FMassVelocityFragment> Velocities = Context.GetMutableFragmentView<FMassVelocityFragment>();
+        const TArrayView<FMassTimeRewindHistoryFragment> Histories = Context.GetMutableFragmentView<FMassTimeRewindHistoryFragment>();
+        const TArrayView<FMassTimeRewindPlaybackFragment> Playbacks = Context.GetMutableFragmentView<FMassTimeRewindPlaybackFragment>();
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+        for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            FMassTimeRewindHistoryFragment& History = Histories[EntityIndex];
+            FMassTimeRewindPlaybackFragment& Playback = Playbacks[EntityIndex];
+
+            Playback.RewindProgress = FMath::Min(Playback.RewindProgress + DeltaTime / Settings.RewindDuration, 1.0f);
+
+            const double TargetTime = Playback.RewindStartTime - (Playback.RewindProgress * Settings.RewindHistoryDuration);
+            FTransform& Transform = Transforms[EntityIndex].GetMutableTransform();
+            FVector Velocity;
+            if (History.Sample(TargetTime, Transform, Velocity) && Velocities.Num() > 0)
+            {
+                Velocities[EntityIndex].Value = Velocity;
+            }
+
+            if (Playback.RewindProgress >= 1.0f)
+            {
+                // Same as UTimeRewindComponent::StopTimeRewind, the final state is applied above so the
+                // entity stands where the kept history ends
+                History.Branch(TargetTime, Now);
+                Playback.RewindProgress = 0.0f;
+                History.RecordTimer = 0.0f;
+                Context.Defer().RemoveTag<FMassTimeRewindingTag>(Context.GetEntity(EntityIndex));
+            }
+        }
+    });
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassTimeRewindProcessors.generated.h"
+
+// Records transform history for entities that are not rewinding and starts any queued rewinds
+UCLASS()
+class ELECTIVEX_API UMassTimeRewindRecordProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UMassTimeRewindRecordProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+// Plays recorded history back for rewinding entities, same timing as UTimeRewindComponent
+UCLASS()
+class ELECTIVEX_API UMassTimeRewindPlaybackProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UMassTimeRewindPlaybackProcessor();
+
+protected:
+    virtual void ConfigureQueries() override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
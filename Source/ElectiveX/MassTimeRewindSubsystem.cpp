@@ -0,0 +1,21 @@
+#include "MassTimeRewindSubsystem.h"
+
+int32 UMassTimeRewindSubsystem::StartTimeRewind(FVector Origin, float Radius)
+{
+    const int32 RequestId = NextRequestId++;
+    PendingRequests.Add({ RequestId, Origin, Radius });
+    return RequestId;
+}
+
+TArray<FMassTimeRewindRequest> UMassTimeRewindSubsystem::ConsumeRewindRequests()
+{
+    return MoveTemp(PendingRequests);
+}
+
+void UMassTimeRewindSubsystem::ResolveRewindRequests(TConstArrayView<FMassTimeRewindRequest> Requests, TConstArrayView<int32> NumEntitiesPerRequest)
+{
+    for (int32 Index = 0; Index < Requests.Num(); ++Index)
+    {
+        OnRewindStarted.Broadcast(Requests[Index].Id, NumEntitiesPerRequest[Index]);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassTimeRewindSubsystem.generated.h"
+
+struct FMassTimeRewindRequest
+{
+    int32 Id = 0;
+    FVector Origin = FVector::ZeroVector;
+    float Radius = 0.0f;
+};
+
+// Request id and the number of entities it started rewinding
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMassTimeRewindStarted, int32, int32);
+
+// Queues rewind requests for Mass entities; the record processor picks them up on its next run
+UCLASS()
+class ELECTIVEX_API UMassTimeRewindSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Returns the request id OnRewindStarted reports it under once the record processor has run
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    int32 StartTimeRewind(FVector Origin, float Radius);
+
+    // Record processor only, on the game thread
+    TArray<FMassTimeRewindRequest> ConsumeRewindRequests();
+    void ResolveRewindRequests(TConstArrayView<FMassTimeRewindRequest> Requests, TConstArrayView<int32> NumEntitiesPerRequest);
+
+    // Broadcast once per request, including ones that found no entities in range
+    FOnMassTimeRewindStarted OnRewindStarted;
+
+private:
+    TArray<FMassTimeRewindRequest> PendingRequests;
+    int32 NextRequestId = 1;
+};
@@ -0,0 +1,16 @@
+#include "MassTimeRewindTrait.h"
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+
+void UMassTimeRewindTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+    BuildContext.RequireFragment<FTransformFragment>();
+
+    BuildContext.AddFragment<FMassTimeRewindHistoryFragment>();
+    BuildContext.AddFragment<FMassTimeRewindPlaybackFragment>();
+
+    FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+    const FConstSharedStruct SettingsFragment = EntityManager.GetOrCreateConstSharedFragment(Settings);
+    BuildContext.AddConstSharedFragment(SettingsFragment);
+}
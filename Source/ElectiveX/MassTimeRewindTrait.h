@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "MassTimeRewindTypes.h"
+#include "MassTimeRewindTrait.generated.h"
+
+// Adds transform history recording and rewind playback to a Mass entity config
+UCLASS(meta = (DisplayName = "Time Rewind"))
+class ELECTIVEX_API UMassTimeRewindTrait : public UMassEntityTraitBase
+{
+    GENERATED_BODY()
+
+protected:
+    virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+
+    UPROPERTY(EditAnywhere, Category = "Time Travel")
+    FMassTimeRewindSettingsFragment Settings;
+};
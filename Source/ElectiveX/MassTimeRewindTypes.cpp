@@ -0,0 +1,125 @@
+#include "MassTimeRewindTypes.h"
+#include "TimeRewindCompression.h"
+#include "TimeRewindInterpolation.h"
+
+namespace
+{
+    // Offsets past this are rebased, float keeps well under a millisecond of precision below it
+    constexpr double MaxTimeOffset = 256.0;
+}
+
+int32 FMassTimeRewindSettingsFragment::GetMaxHistoryStates() const
+{
+    const float Duration = FMath::Max(MaxHistoryDuration, RewindHistoryDuration);
+    return FMath::Min(FMath::CeilToInt(Duration / RecordInterval) + 1, FMassTimeRewindHistoryFragment::Capacity);
+}
+
+void FMassTimeRewindHistoryFragment::Record(double Time, const FTransform& Transform, int32 MaxSamples)
+{
+    MaxSamples = FMath::Clamp(MaxSamples, 2, Capacity);
+    if (NumSamples == 0)
+    {
+        Head = 0;
+        BaseTime = Time;
+    }
+
+    while (NumSamples >= MaxSamples)
+    {
+        Head = (Head + 1) % Capacity;
+        --NumSamples;
+    }
+
+    if (Time - BaseTime > MaxTimeOffset)
+    {
+        Rebase();
+    }
+
+    FMassTimeRewindSample& Sample = Samples[(Head + NumSamples) % Capacity];
+    Sample.Location = FVector3f(Transform.GetLocation());
+    const FQuat4f Rotation(Transform.GetRotation());
+    TimeRewindCore::PackQuaternion(&Rotation.X, Sample.Rotation);
+    Sample.Time = (float)(Time - BaseTime);
+    ++NumSamples;
+}
+
+bool FMassTimeRewindHistoryFragment::Sample(double Time, FTransform& InOutTransform, FVector& OutVelocity) const
+{
+    if (NumSamples == 0)
+        return false;
+
+    const int32 Next = UpperBound(Time);
+    if (Next == 0 || Next == NumSamples)
+    {
+        const FMassTimeRewindSample& Nearest = At(Next == 0 ? 0 : NumSamples - 1);
+        FQuat4f Rotation;
+        TimeRewindCore::UnpackQuaternion(Nearest.Rotation, &Rotation.X);
+        InOutTransform.SetLocation(FVector(Nearest.Location));
+        InOutTransform.SetRotation(FQuat(Rotation));
+        OutVelocity = FVector::ZeroVector;
+        return true;
+    }
+
+    const int32 Prev = FMath::Max(Next - 2, 0);
+    const int32 From = Next - 1;
+    const int32 To = Next;
+    const int32 After = FMath::Min(Next + 1, NumSamples - 1);
+    const double FromTime = TimeAt(From);
+    const double Span = TimeAt(To) - FromTime;
+    const float Alpha = Span > UE_SMALL_NUMBER ? (float)((Time - FromTime) / Span) : 0.0f;
+
+    // Position follows a Catmull-Rom spline through the neighbouring samples
+    float StartTangent[3], EndTangent[3], Location[3], Derivative[3];
+    TimeRewindCore::CatmullRomTangent(&At(Prev).Location.X, &At(To).Location.X, (float)(TimeAt(To) - TimeAt(Prev)), (float)Span, StartTangent);
+    TimeRewindCore::CatmullRomTangent(&At(From).Location.X, &At(After).Location.X, (float)(TimeAt(After) - FromTime), (float)Span, EndTangent);
+    TimeRewindCore::CubicHermite(&At(From).Location.X, StartTangent, &At(To).Location.X, EndTangent, Alpha, Location);
+    TimeRewindCore::CubicHermiteDerivative(&At(From).Location.X, StartTangent, &At(To).Location.X, EndTangent, Alpha, Derivative);
+
+    float Rotations[4][4];
+    TimeRewindCore::UnpackQuaternion(At(Prev).Rotation, Rotations[0]);
+    TimeRewindCore::UnpackQuaternion(At(From).Rotation, Rotations[1]);
+    TimeRewindCore::UnpackQuaternion(At(To).Rotation, Rotations[2]);
+    TimeRewindCore::UnpackQuaternion(At(After).Rotation, Rotations[3]);
+    FQuat4f Rotation;
+    TimeRewindCore::Squad(Rotations[0], Rotations[1], Rotations[2], Rotations[3], Alpha, &Rotation.X);
+
+    InOutTransform.SetLocation(FVector(Location[0], Location[1], Location[2]));
+    InOutTransform.SetRotation(FQuat(Rotation));
+    OutVelocity = Span > UE_SMALL_NUMBER ? FVector(Derivative[0], Derivative[1], Derivative[2]) / Span : FVector::ZeroVector;
+    return true;
+}
+
+void FMassTimeRewindHistoryFragment::Branch(double BranchTime, double Now)
+{
+    NumSamples = UpperBound(BranchTime);
+    BaseTime += Now - BranchTime;
+}
+
+int32 FMassTimeRewindHistoryFragment::UpperBound(double Time) const
+{
+    int32 Low = 0;
+    int32 High = NumSamples;
+    while (Low < High)
+    {
+        const int32 Mid = Low + (High - Low) / 2;
+        if (TimeAt(Mid) <= Time)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+    return Low;
+}
+
+void FMassTimeRewindHistoryFragment::Rebase()
+{
+    const double NewBaseTime = NumSamples > 0 ? TimeAt(0) : BaseTime;
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        FMassTimeRewindSample& Sample = Samples[(Head + Index) % Capacity];
+        Sample.Time = (float)(BaseTime + Sample.Time - NewBaseTime);
+    }
+    BaseTime = NewBaseTime;
+}
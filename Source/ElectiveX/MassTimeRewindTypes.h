@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "MassTimeRewindTypes.generated.h"
+
+// Rewind settings shared by every entity of an archetype
+USTRUCT()
+struct FMassTimeRewindSettingsFragment : public FMassConstSharedFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Time Travel")
+    float RecordInterval = 0.1f;
+
+    UPROPERTY(EditAnywhere, Category = "Time Travel")
+    float RewindDuration = 4.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Time Travel")
+    float RewindHistoryDuration = 4.0f;
+
+    // Seconds of history kept, several rewind windows so a landed rewind can be rewound again.
+    // Limited to FMassTimeRewindHistoryFragment::Capacity samples.
+    UPROPERTY(EditAnywhere, Category = "Time Travel")
+    float MaxHistoryDuration = 12.0f;
+
+    int32 GetMaxHistoryStates() const;
+};
+
+// One recorded state of an entity, rotation packed to 16 bits per axis. Velocity is not stored,
+// playback derives it from the interpolated path.
+struct FMassTimeRewindSample
+{
+    FVector3f Location;
+    int16 Rotation[4];
+    // Seconds after the history's base time
+    float Time;
+};
+static_assert(sizeof(FMassTimeRewindSample) == 24, "Every crowd entity stores Capacity samples inline, keep them small");
+
+// Recorded states of one entity in a fixed ring stored inline in the fragment, so recording never
+// allocates and a chunk of entities holds its history contiguously
+USTRUCT()
+struct FMassTimeRewindHistoryFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    static constexpr int32 Capacity = 128;
+
+    // Appends a sample at Time, which must not be older than the newest one, dropping the oldest
+    // beyond MaxSamples
+    void Record(double Time, const FTransform& Transform, int32 MaxSamples);
+
+    // Writes the location and rotation at Time into InOutTransform, scale is left as it is
+    bool Sample(double Time, FTransform& InOutTransform, FVector& OutVelocity) const;
+
+    // Drops everything recorded after BranchTime and shifts the rest so BranchTime lines up with Now
+    void Branch(double BranchTime, double Now);
+
+    int32 Num() const { return NumSamples; }
+
+    float RecordTimer = 0.0f;
+
+private:
+    const FMassTimeRewindSample& At(int32 Index) const { return Samples[(Head + Index) % Capacity]; }
+    double TimeAt(int32 Index) const { return BaseTime + At(Index).Time; }
+
+    // Number of samples recorded at or before Time
+    int32 UpperBound(double Time) const;
+
+    // Moves the base time up to the oldest sample so offsets stay small enough for float precision
+    void Rebase();
+
+    FMassTimeRewindSample Samples[Capacity];
+    double BaseTime = 0.0;
+    // Ring index of the oldest sample
+    int32 Head = 0;
+    int32 NumSamples = 0;
+};
+
+USTRUCT()
+struct FMassTimeRewindPlaybackFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    double RewindStartTime = 0.0;
+
+    float RewindProgress = 0.0f;
+};
+
+// Present while the entity is playing its history back
+USTRUCT()
+struct FMassTimeRewindingTag : public FMassTag
+{
+    GENERATED_BODY()
+};
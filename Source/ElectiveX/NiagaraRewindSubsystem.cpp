@@ -0,0 +1,212 @@
+#include "NiagaraRewindSubsystem.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+
+void FNiagaraRewindParameters::ApplyTo(UNiagaraComponent& Component) const
+{
+    for (const TPair<FName, float>& Parameter : Floats)
+    {
+        Component.SetVariableFloat(Parameter.Key, Parameter.Value);
+    }
+    for (const TPair<FName, FVector>& Parameter : Vectors)
+    {
+        Component.SetVariableVec3(Parameter.Key, Parameter.Value);
+    }
+    for (const TPair<FName, FLinearColor>& Parameter : Colors)
+    {
+        Component.SetVariableLinearColor(Parameter.Key, Parameter.Value);
+    }
+}
+
+UNiagaraComponent* UNiagaraRewindSubsystem::SpawnRewindableSystem(UNiagaraSystem* System, FVector Location, FRotator Rotation, const FNiagaraRewindParameters& Parameters)
+{
+    if (!System)
+        return nullptr;
+
+    UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, System, Location, Rotation,
+        FVector::OneVector, true, false);
+    if (!Component)
+        return nullptr;
+
+    FNiagaraRewindRecord& Record = Records.AddDefaulted_GetRef();
+    Record.System = System;
+    Record.Component = Component;
+    Record.Location = Location;
+    Record.Rotation = Rotation;
+    Record.Parameters = Parameters;
+    Record.SpawnTime = GetWorld()->GetTimeSeconds();
+    Record.Seed = (int32)SeedStream.GetUnsignedInt();
+
+    Component->SetRandomSeedOffset(Record.Seed);
+    Parameters.ApplyTo(*Component);
+    Component->Activate(true);
+    return Component;
+}
+
+int32 UNiagaraRewindSubsystem::StartTimeRewind(FVector Origin, float Radius)
+{
+    if (bIsRewinding)
+        return 0;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    TrimRecords(Now);
+
+    RewindingRecords.Reset();
+    for (int32 Index = 0; Index < Records.Num(); ++Index)
+    {
+        if (FVector::DistSquared(Records[Index].Location, Origin) <= FMath::Square(Radius))
+        {
+            Records[Index].SeekedAge = -1.0;
+            RewindingRecords.Add(Index);
+        }
+    }
+
+    if (RewindingRecords.Num() == 0)
+        return 0;
+
+    bIsRewinding = true;
+    RewindProgress = 0.0f;
+    RewindStartTime = Now;
+    SeekCursor = 0;
+    return RewindingRecords.Num();
+}
+
+void UNiagaraRewindSubsystem::StopTimeRewind()
+{
+    if (!bIsRewinding)
+        return;
+
+    bIsRewinding = false;
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double TargetTime = RewindStartTime - (FMath::Min(RewindProgress, 1.0f) * RewindHistoryDuration);
+
+    // Effects carry on from their rewound age; ones that had not spawned yet are gone
+    for (int32 Index = RewindingRecords.Num() - 1; Index >= 0; --Index)
+    {
+        FNiagaraRewindRecord& Record = Records[RewindingRecords[Index]];
+        UNiagaraComponent* Component = Record.Component.Get();
+        const double Age = TargetTime - Record.SpawnTime;
+
+        if (Age < 0.0)
+        {
+            if (Component)
+            {
+                Component->DestroyComponent();
+            }
+            Records.RemoveAt(RewindingRecords[Index]);
+            continue;
+        }
+
+        // Systems carry on from the age they were last seeked to, which can trail the target by a step;
+        // ones never seeked were left running and keep their spawn time
+        if (Record.SeekedAge >= 0.0)
+        {
+            Record.SpawnTime = Now - Record.SeekedAge;
+        }
+        if (Component)
+        {
+            Component->SetAgeUpdateMode(ENiagaraAgeUpdateMode::TickDeltaTime);
+            Component->SetAutoDestroy(true);
+        }
+    }
+
+    RewindingRecords.Reset();
+}
+
+void UNiagaraRewindSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!bIsRewinding)
+    {
+        TrimRecords(GetWorld()->GetTimeSeconds());
+        return;
+    }
+
+    RewindProgress += DeltaTime / RewindDuration;
+    if (RewindProgress >= 1.0f)
+    {
+        StopTimeRewind();
+        return;
+    }
+
+    const double TargetTime = RewindStartTime - (RewindProgress * RewindHistoryDuration);
+    const int32 NumRewinding = RewindingRecords.Num();
+    int32 NumSeeks = 0;
+    int32 Step = 0;
+    for (; Step < NumRewinding && NumSeeks < MaxSeeksPerFrame; ++Step)
+    {
+        if (SeekRecord(Records[RewindingRecords[(SeekCursor + Step) % NumRewinding]], TargetTime))
+        {
+            ++NumSeeks;
+        }
+    }
+    SeekCursor = NumRewinding > 0 ? (SeekCursor + Step) % NumRewinding : 0;
+}
+
+TStatId UNiagaraRewindSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UNiagaraRewindSubsystem, STATGROUP_Tickables);
+}
+
+bool UNiagaraRewindSubsystem::SeekRecord(FNiagaraRewindRecord& Record, double TargetTime)
+{
+    UNiagaraComponent* Component = Record.Component.Get();
+    const double Age = TargetTime - Record.SpawnTime;
+
+    if (Age < 0.0)
+    {
+        if (Component && Component->IsActive())
+        {
+            Component->DeactivateImmediate();
+        }
+        Record.SeekedAge = -1.0;
+        return false;
+    }
+
+    if (Record.SeekedAge >= 0.0 && Record.SeekedAge - Age < MinSeekStep)
+        return false;
+
+    if (!Component)
+    {
+        // The original finished and destroyed itself, respawn it with the same seed and parameters
+        Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, Record.System.Get(), Record.Location, Record.Rotation,
+            FVector::OneVector, false, false);
+        if (!Component)
+            return false;
+
+        Component->SetRandomSeedOffset(Record.Seed);
+        Record.Parameters.ApplyTo(*Component);
+        Record.Component = Component;
+    }
+
+    if (Component->GetAgeUpdateMode() != ENiagaraAgeUpdateMode::DesiredAge)
+    {
+        // Re-simulation starts from spawn, gameplay may have changed parameters on the live effect since
+        Record.Parameters.ApplyTo(*Component);
+        Component->SetAutoDestroy(false);
+        Component->SetAgeUpdateMode(ENiagaraAgeUpdateMode::DesiredAge);
+        Component->SetSeekDelta(SeekDelta);
+        Component->SetMaxSimTime(MaxSeekSimTime);
+    }
+
+    if (!Component->IsActive())
+    {
+        Component->Activate(true);
+    }
+
+    // Seeking backwards resets the system and re-simulates it up to the desired age
+    Component->SetDesiredAge(Age);
+    Record.SeekedAge = Age;
+    return true;
+}
+
+void UNiagaraRewindSubsystem::TrimRecords(double Now)
+{
+    const double OldestSpawnTime = Now - RewindHistoryDuration - MaxEffectAge;
+    Records.RemoveAll([OldestSpawnTime](const FNiagaraRewindRecord& Record)
+    {
+        return Record.SpawnTime < OldestSpawnTime || !Record.System.IsValid();
+    });
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NiagaraRewindSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+// User parameters an effect is spawned with, set again whenever it is re-simulated from spawn
+USTRUCT(BlueprintType)
+struct FNiagaraRewindParameters
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    TMap<FName, float> Floats;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    TMap<FName, FVector> Vectors;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    TMap<FName, FLinearColor> Colors;
+
+    void ApplyTo(UNiagaraComponent& Component) const;
+};
+
+// Everything needed to re-simulate an effect, particles themselves are never recorded
+struct FNiagaraRewindRecord
+{
+    TWeakObjectPtr<UNiagaraSystem> System;
+    TWeakObjectPtr<UNiagaraComponent> Component;
+    FVector Location;
+    FRotator Rotation;
+    FNiagaraRewindParameters Parameters;
+    double SpawnTime;
+    int32 Seed;
+    // Age the component was last seeked to during the current rewind, negative when it was not
+    double SeekedAge = -1.0;
+};
+
+// Spawns effects with a known seed and rewinds them by seeking the system to its age at the
+// rewound time. Systems need deterministic random numbers enabled to replay identically.
+UCLASS()
+class ELECTIVEX_API UNiagaraRewindSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    float RewindDuration = 4.0f;
+    float RewindHistoryDuration = 4.0f;
+
+    // Effects older than this when the rewind window starts are assumed finished
+    float MaxEffectAge = 5.0f;
+
+    // Simulation step used when seeking a system to its rewound age
+    float SeekDelta = 1.0f / 30.0f;
+
+    // Wall time in seconds one system may spend re-simulating per frame, a longer seek carries on next frame
+    float MaxSeekSimTime = 0.002f;
+
+    // A backwards seek re-simulates the system from spawn, so the rewound age only moves in steps this large
+    float MinSeekStep = 0.1f;
+
+    // Systems seeked per frame, the rest keep their last age until their turn comes round
+    int32 MaxSeeksPerFrame = 4;
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel", meta = (AutoCreateRefTerm = "Parameters"))
+    UNiagaraComponent* SpawnRewindableSystem(UNiagaraSystem* System, FVector Location, FRotator Rotation, const FNiagaraRewindParameters& Parameters);
+
+    // Returns the number of effects in range that will be rewound
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    int32 StartTimeRewind(FVector Origin, float Radius);
+
+    void StopTimeRewind();
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    // Returns true when the record was seeked, which is what MaxSeeksPerFrame limits
+    bool SeekRecord(FNiagaraRewindRecord& Record, double TargetTime);
+    void TrimRecords(double Now);
+
+    TArray<FNiagaraRewindRecord> Records;
+    // Effect seeds, separate from FMath::Rand so the same spawns get the same seeds every run
+    FRandomStream SeedStream;
+    // Records taking part in the current rewind
+    TArray<int32> RewindingRecords;
+    // Position in RewindingRecords the next frame starts seeking from
+    int32 SeekCursor = 0;
+
+    bool bIsRewinding = false;
+    float RewindProgress = 0.0f;
+    double RewindStartTime = 0.0;
+};
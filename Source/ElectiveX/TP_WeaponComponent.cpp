@@ -44,7 +44,11 @@ void UTP_WeaponComponent::Fire()
 			ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
 	
 			// Spawn the projectile at the muzzle
-			World->SpawnActor<AElectiveXProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+			AElectiveXProjectile* Projectile = World->SpawnActor<AElectiveXProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+			if (Projectile != nullptr && bReplayKnockbacks)
+			{
+				Projectile->SetReplayViewer(PlayerController);
+			}
 		}
 	}
 	
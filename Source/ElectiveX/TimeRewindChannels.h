@@ -0,0 +1,462 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "TimeRewindHistory.h"
+#include "TimeRewindInterpolation.h"
+#include "TimeState.h"
+
+/*
+ * Recorded history is laid out from a list of channels chosen at compile time. Each channel owns a
+ * small FData struct plus static Record/Blend/Apply/ToState functions; TTimeHistoryTrack<Channels...>
+ * stores samples that inherit every FData and folds over the channels, so an actor only stores and
+ * processes what its layout names and no per-sample branching or component lookups happen.
+ */
+
+// Components a track reads from and writes to, resolved once when the track is created
+struct FTimeRewindBinding
+{
+    AActor* Owner = nullptr;
+    USceneComponent* Root = nullptr;
+    UPrimitiveComponent* Primitive = nullptr;
+    UCharacterMovementComponent* Movement = nullptr;
+
+    static FTimeRewindBinding Resolve(AActor* Owner)
+    {
+        FTimeRewindBinding Binding;
+        Binding.Owner = Owner;
+        Binding.Root = Owner->GetRootComponent();
+        Binding.Primitive = Cast<UPrimitiveComponent>(Binding.Root);
+        Binding.Movement = Owner->FindComponentByClass<UCharacterMovementComponent>();
+        return Binding;
+    }
+};
+
+// Four neighbouring samples around the target time, From/To bracket it
+template <typename TSample>
+struct TTimeBlendInput
+{
+    const TSample& Prev;
+    const TSample& From;
+    const TSample& To;
+    const TSample& Next;
+    float Alpha;
+    float Span;
+};
+
+// Scratch state shared by the channels while one sample is applied
+struct FTimeRewindApplyContext
+{
+    const FTimeRewindBinding& Binding;
+    FTransform Transform;
+    bool bSimulatingPhysics;
+};
+
+template <typename TSample, typename TChannel>
+constexpr bool THasTimeChannel = TIsDerivedFrom<TSample, typename TChannel::FData>::Value;
+
+struct FLinearVelocityChannel;
+
+struct FPositionChannel
+{
+    struct FData
+    {
+        FVector Location = FVector::ZeroVector;
+    };
+
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        Out.Location = Binding.Root->GetComponentLocation();
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        const FVector& P0 = In.From.Location;
+        const FVector& P1 = In.To.Location;
+
+        // Hermite with recorded velocities when the layout has them, Catmull-Rom tangents otherwise
+        FVector T0, T1;
+        if constexpr (THasTimeChannel<TSample, FLinearVelocityChannel>)
+        {
+            T0 = FVector(In.From.LinearVelocity) * In.Span;
+            T1 = FVector(In.To.LinearVelocity) * In.Span;
+        }
+        else
+        {
+            TimeRewindCore::CatmullRomTangent<double>(&In.Prev.Location.X, &P1.X, In.To.Time - In.Prev.Time, In.Span, &T0.X);
+            TimeRewindCore::CatmullRomTangent<double>(&P0.X, &In.Next.Location.X, In.Next.Time - In.From.Time, In.Span, &T1.X);
+        }
+        TimeRewindCore::CubicHermite<double>(&P0.X, &T0.X, &P1.X, &T1.X, In.Alpha, &Out.Location.X);
+    }
+
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        Context.Transform.SetLocation(Data.Location);
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.Transform.SetLocation(Data.Location);
+    }
+};
+
+struct FRotationChannel
+{
+    struct FData
+    {
+        FQuat4f Rotation = FQuat4f::Identity;
+    };
+
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        Out.Rotation = FQuat4f(Binding.Root->GetComponentQuat());
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        // Squad with tangents from the neighbouring samples
+        TimeRewindCore::Squad(&In.Prev.Rotation.X, &In.From.Rotation.X, &In.To.Rotation.X, &In.Next.Rotation.X, In.Alpha, &Out.Rotation.X);
+    }
+
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        Context.Transform.SetRotation(FQuat(Data.Rotation));
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.Transform.SetRotation(FQuat(Data.Rotation));
+    }
+};
+
+struct FScaleChannel
+{
+    struct FData
+    {
+        FVector3f Scale = FVector3f::OneVector;
+    };
+
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        Out.Scale = FVector3f(Binding.Root->GetComponentScale());
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        Out.Scale = FMath::Lerp(In.From.Scale, In.To.Scale, In.Alpha);
+    }
+
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        Context.Transform.SetScale3D(FVector(Data.Scale));
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.Transform.SetScale3D(FVector(Data.Scale));
+    }
+};
+
+struct FLinearVelocityChannel
+{
+    struct FData
+    {
+        FVector3f LinearVelocity = FVector3f::ZeroVector;
+    };
+
+    // Character, projectile and physics movement all report through the root component
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        Out.LinearVelocity = FVector3f(Binding.Root->GetComponentVelocity());
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        Out.LinearVelocity = FMath::Lerp(In.From.LinearVelocity, In.To.LinearVelocity, In.Alpha);
+    }
+
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        if (Context.bSimulatingPhysics)
+        {
+            Context.Binding.Primitive->SetPhysicsLinearVelocity(FVector(Data.LinearVelocity));
+        }
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.Velocity = FVector(Data.LinearVelocity);
+    }
+};
+
+struct FAngularVelocityChannel
+{
+    struct FData
+    {
+        FVector3f AngularVelocity = FVector3f::ZeroVector;
+    };
+
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        Out.AngularVelocity = Binding.Primitive ? FVector3f(Binding.Primitive->GetPhysicsAngularVelocityInRadians()) : FVector3f::ZeroVector;
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        Out.AngularVelocity = FMath::Lerp(In.From.AngularVelocity, In.To.AngularVelocity, In.Alpha);
+    }
+
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        if (Context.bSimulatingPhysics)
+        {
+            Context.Binding.Primitive->SetPhysicsAngularVelocityInRadians(FVector(Data.AngularVelocity));
+        }
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.AngularVelocity = FVector(Data.AngularVelocity);
+    }
+};
+
+struct FMovementModeChannel
+{
+    struct FData
+    {
+        uint8 MovementMode = MOVE_None;
+        bool bWasMoving = false;
+    };
+
+    static void Record(const FTimeRewindBinding& Binding, FData& Out)
+    {
+        if (Binding.Movement)
+        {
+            Out.MovementMode = Binding.Movement->MovementMode;
+            Out.bWasMoving = Binding.Movement->Velocity.Size() > 1.0f;
+        }
+    }
+
+    template <typename TSample>
+    static void Blend(const TTimeBlendInput<TSample>& In, FData& Out)
+    {
+        const FData& Nearest = In.Alpha < 0.5f ? In.From : In.To;
+        Out = Nearest;
+    }
+
+    // Playback moves the actor directly, the mode keeps movement logic such as falling in step with it
+    static void Apply(const FData& Data, FTimeRewindApplyContext& Context)
+    {
+        UCharacterMovementComponent* Movement = Context.Binding.Movement;
+        if (Movement && Data.MovementMode != MOVE_None && Movement->MovementMode != Data.MovementMode)
+        {
+            Movement->SetMovementMode((EMovementMode)Data.MovementMode);
+        }
+    }
+
+    static void ToState(const FData& Data, FTimeState& OutState)
+    {
+        OutState.MovementMode = Data.MovementMode;
+        OutState.bWasMoving = Data.bWasMoving;
+    }
+};
+
+// One recorded sample, Time is in seconds relative to the owning track's base time
+template <typename... TChannels>
+struct TTimeSample : public TChannels::FData...
+{
+    float Time = 0.0f;
+};
+
+// Type-erased history so the component can pick a layout at BeginPlay; one virtual call per
+// record or playback step, everything per channel below it is inlined
+class FTimeHistoryTrack
+{
+public:
+    virtual ~FTimeHistoryTrack() = default;
+
+    virtual void Record(double Time) = 0;
+    virtual void Trim(int32 MaxStates) = 0;
+    // Keeps one sample older than OldestTime so the whole window can still be sampled
+    virtual void TrimBefore(double OldestTime) = 0;
+    virtual void Reset() = 0;
+    // Drops everything recorded after BranchTime and shifts the rest so BranchTime lines up with Now
+    virtual void Branch(double BranchTime, double Now) = 0;
+    virtual int32 Num() const = 0;
+    // Times of the oldest and newest recorded samples, false when nothing is recorded
+    virtual bool GetTimeRange(double& OutOldest, double& OutNewest) const = 0;
+    // Shares the recorded chunks, recording and branching this track afterwards leave the copy as it was
+    virtual TUniquePtr<FTimeHistoryTrack> Clone() const = 0;
+
+    // Channels missing from the layout leave OutState untouched
+    virtual bool SampleAtTime(double Time, FTimeState& OutState) const = 0;
+    virtual bool ApplyAtTime(double Time, FTimeState& OutState) = 0;
+    virtual bool GetLatestState(FTimeState& OutState) const = 0;
+    // The recorded sample nearest Time as it was stored, OutState.Timestamp is its time
+    virtual bool GetNearestState(double Time, FTimeState& OutState) const = 0;
+    // Reads the owner's current state through the same channels a recorded sample goes through
+    virtual void CaptureState(FTimeState& OutState) const = 0;
+};
+
+// Samples live in a TimeRewindCore::TChunkedHistory, so a rewind branches the timeline instead of clearing it
+template <typename... TChannels>
+class TTimeHistoryTrack final : public FTimeHistoryTrack
+{
+public:
+    using FSample = TTimeSample<TChannels...>;
+
+    explicit TTimeHistoryTrack(const FTimeRewindBinding& InBinding)
+        : Binding(InBinding)
+    {
+    }
+
+    virtual void Record(double Time) override
+    {
+        FSample& Sample = History.Append(Time);
+        (TChannels::Record(Binding, Sample), ...);
+    }
+
+    virtual void Trim(int32 MaxStates) override
+    {
+        History.Trim(MaxStates);
+    }
+
+    virtual void TrimBefore(double OldestTime) override
+    {
+        History.TrimBefore(OldestTime);
+    }
+
+    virtual void Reset() override
+    {
+        History.Reset();
+    }
+
+    virtual void Branch(double BranchTime, double Now) override
+    {
+        History.Branch(BranchTime, Now);
+    }
+
+    virtual int32 Num() const override
+    {
+        return History.Num();
+    }
+
+    virtual bool GetTimeRange(double& OutOldest, double& OutNewest) const override
+    {
+        const int32 NumSamples = History.Num();
+        if (NumSamples == 0)
+            return false;
+
+        OutOldest = History.TimeAt(0);
+        OutNewest = History.TimeAt(NumSamples - 1);
+        return true;
+    }
+
+    virtual TUniquePtr<FTimeHistoryTrack> Clone() const override
+    {
+        return MakeUnique<TTimeHistoryTrack>(*this);
+    }
+
+    virtual bool SampleAtTime(double Time, FTimeState& OutState) const override
+    {
+        FSample Sample;
+        if (!Evaluate(Time, Sample))
+            return false;
+
+        ToState(Sample, Time, OutState);
+        return true;
+    }
+
+    virtual bool ApplyAtTime(double Time, FTimeState& OutState) override
+    {
+        FSample Sample;
+        if (!Evaluate(Time, Sample))
+            return false;
+
+        FTimeRewindApplyContext Context { Binding, Binding.Owner->GetActorTransform(),
+            Binding.Primitive && Binding.Primitive->IsSimulatingPhysics() };
+        (TChannels::Apply(Sample, Context), ...);
+        Binding.Owner->SetActorTransform(Context.Transform);
+
+        ToState(Sample, Time, OutState);
+        return true;
+    }
+
+    virtual bool GetLatestState(FTimeState& OutState) const override
+    {
+        const int32 NumSamples = History.Num();
+        if (NumSamples == 0)
+            return false;
+
+        ToState(History.At(NumSamples - 1), History.TimeAt(NumSamples - 1), OutState);
+        return true;
+    }
+
+    virtual bool GetNearestState(double Time, FTimeState& OutState) const override
+    {
+        typename FHistory::FBracket Bracket;
+        if (!History.FindBracket(Time, Bracket))
+            return false;
+
+        const int32 Nearest = Bracket.Alpha < 0.5f ? Bracket.From : Bracket.To;
+        ToState(History.At(Nearest), History.TimeAt(Nearest), OutState);
+        return true;
+    }
+
+    virtual void CaptureState(FTimeState& OutState) const override
+    {
+        FSample Sample;
+        (TChannels::Record(Binding, Sample), ...);
+        ToState(Sample, 0.0, OutState);
+    }
+
+private:
+    using FHistory = TimeRewindCore::TChunkedHistory<FSample>;
+
+    // Copy of a sample with its time made relative to Origin, neighbours can sit in different chunks
+    FSample LocalSample(int32 Index, double Origin) const
+    {
+        FSample Sample = History.At(Index);
+        Sample.Time = (float)(History.TimeAt(Index) - Origin);
+        return Sample;
+    }
+
+    bool Evaluate(double Time, FSample& OutSample) const
+    {
+        typename FHistory::FBracket Bracket;
+        if (!History.FindBracket(Time, Bracket))
+            return false;
+
+        if (Bracket.IsClamped())
+        {
+            OutSample = History.At(Bracket.From);
+            return true;
+        }
+
+        const double Origin = History.TimeAt(Bracket.From);
+        const FSample Prev = LocalSample(Bracket.Prev, Origin);
+        const FSample From = LocalSample(Bracket.From, Origin);
+        const FSample To = LocalSample(Bracket.To, Origin);
+        const FSample After = LocalSample(Bracket.Next, Origin);
+        const TTimeBlendInput<FSample> In { Prev, From, To, After, Bracket.Alpha, To.Time };
+
+        (TChannels::Blend(In, static_cast<typename TChannels::FData&>(OutSample)), ...);
+        return true;
+    }
+
+    void ToState(const FSample& Sample, double Time, FTimeState& OutState) const
+    {
+        (TChannels::ToState(Sample, OutState), ...);
+        OutState.Timestamp = Time;
+    }
+
+    FTimeRewindBinding Binding;
+    FHistory History;
+};
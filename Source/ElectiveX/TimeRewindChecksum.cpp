@@ -0,0 +1,441 @@
+#include "TimeRewindChecksum.h"
+#include "TimeRewindComponent.h"
+#include "TimeState.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+static TAutoConsoleVariable<bool> CVarRewindChecksums(
+    TEXT("rewind.Checksums"),
+    false,
+    TEXT("Write per-frame checksums of recorded rewind states to Saved/Checksums and verify where rewinds land."));
+
+static TAutoConsoleVariable<float> CVarRewindChecksumQuantum(
+    TEXT("rewind.Checksums.Quantum"),
+    0.01f,
+    TEXT("Grid in world units that positions and velocities are snapped to before hashing. Values within float noise of a grid line can still disagree."));
+
+static TAutoConsoleVariable<float> CVarRewindChecksumTolerance(
+    TEXT("rewind.Checksums.Tolerance"),
+    1.0f,
+    TEXT("World units a landed actor may be off its recorded position, on top of how far it moved since landing."));
+
+static TAutoConsoleVariable<float> CVarRewindChecksumAngleTolerance(
+    TEXT("rewind.Checksums.AngleTolerance"),
+    1.0f,
+    TEXT("Degrees a landed actor may be off its recorded rotation, on top of how far it turned since landing."));
+
+namespace
+{
+    // Rotation and scale are close to unit length, they get a finer grid than positions
+    constexpr float UnitQuantum = 1.e-4f;
+
+    // History times are rebuilt from float offsets, recorded and sampled times of a sample can differ by this much
+    constexpr double TimeMatchWindow = 1.e-3;
+
+    // Seconds between two divergence reports for the same actor, the ones in between are counted
+    constexpr double ReportInterval = 5.0;
+
+    constexpr int32 NumChecksumBatches = 8;
+    constexpr int32 ExpectedRowsPerFrame = 1024;
+
+    int32 Quantize(double Value, float Step)
+    {
+        return (int32)FMath::Clamp<int64>(FMath::RoundToInt64(Value / Step), MIN_int32, MAX_int32);
+    }
+
+    void WriteRecordType(FArchive& Ar, TimeRewindChecksum::ERecordType Type)
+    {
+        uint32 TypeValue = (uint32)Type;
+        Ar << TypeValue;
+    }
+}
+
+FTimeRewindChecksumWriter::FTimeRewindChecksumWriter(const FString& InFilename, int32 NumBatches)
+    : Filename(InFilename)
+    , FreeBatches(NumBatches + 1)
+    , FilledBatches(NumBatches + 1)
+{
+    for (int32 Index = 0; Index < NumBatches; ++Index)
+    {
+        FTimeRewindChecksumBatch* Batch = Batches.Add_GetRef(MakeUnique<FTimeRewindChecksumBatch>()).Get();
+        FreeBatches.Enqueue(Batch);
+    }
+
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool();
+    Thread = FRunnableThread::Create(this, TEXT("RewindChecksumWriter"), 0, TPri_BelowNormal);
+}
+
+FTimeRewindChecksumWriter::~FTimeRewindChecksumWriter()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    WorkEvent = nullptr;
+}
+
+FTimeRewindChecksumBatch* FTimeRewindChecksumWriter::AcquireBatch()
+{
+    FTimeRewindChecksumBatch* Batch = nullptr;
+    FreeBatches.Dequeue(Batch);
+    return Batch;
+}
+
+void FTimeRewindChecksumWriter::SubmitBatch(FTimeRewindChecksumBatch* Batch)
+{
+    // Cannot fail, there are never more batches than queue slots
+    FilledBatches.Enqueue(Batch);
+    WorkEvent->Trigger();
+}
+
+void FTimeRewindChecksumWriter::Stop()
+{
+    bStopRequested = true;
+    WorkEvent->Trigger();
+}
+
+uint32 FTimeRewindChecksumWriter::Run()
+{
+    TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+    if (Ar)
+    {
+        uint32 Magic = TimeRewindChecksum::FileMagic;
+        uint32 Version = TimeRewindChecksum::FileVersion;
+        *Ar << Magic;
+        *Ar << Version;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TimeRewindChecksum: Could not open %s, checksums will be discarded"), *Filename);
+    }
+
+    for (;;)
+    {
+        // Read the flag before draining so nothing submitted ahead of Stop() is missed
+        const bool bStopping = bStopRequested;
+
+        FTimeRewindChecksumBatch* Batch = nullptr;
+        while (FilledBatches.Dequeue(Batch))
+        {
+            if (Ar)
+            {
+                Ar->Serialize(Batch->Bytes.GetData(), Batch->Bytes.Num());
+            }
+            Batch->Bytes.Reset();
+            FreeBatches.Enqueue(Batch);
+        }
+
+        if (bStopping)
+            break;
+
+        WorkEvent->Wait(100);
+    }
+
+    if (Ar)
+    {
+        Ar->Close();
+    }
+    return 0;
+}
+
+bool UTimeRewindChecksumSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // Editor preview and inactive worlds would each open a checksum stream of their own
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTimeRewindChecksumSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (!CVarRewindChecksums.GetValueOnGameThread())
+        return;
+
+    const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Checksums"),
+        FString::Printf(TEXT("RewindChecksums_%s.trwc"), *FDateTime::Now().ToString()));
+    Writer = MakeUnique<FTimeRewindChecksumWriter>(Filename, NumChecksumBatches);
+    FrameRows.Reserve(ExpectedRowsPerFrame);
+    RowHashScratch.Reserve(ExpectedRowsPerFrame * 2);
+
+    Quantum = FMath::Max(CVarRewindChecksumQuantum.GetValueOnGameThread(), UE_SMALL_NUMBER);
+    LocationTolerance = CVarRewindChecksumTolerance.GetValueOnGameThread();
+    AngleTolerance = CVarRewindChecksumAngleTolerance.GetValueOnGameThread();
+    FirstFrame = GFrameCounter;
+    CurrentFrame = GFrameCounter;
+
+    UE_LOG(LogTemp, Log, TEXT("TimeRewindChecksum: Writing to %s"), *Filename);
+}
+
+void UTimeRewindChecksumSubsystem::Deinitialize()
+{
+    if (Writer)
+    {
+        FlushFrame();
+        if (CurrentBatch)
+        {
+            Writer->SubmitBatch(CurrentBatch);
+            CurrentBatch = nullptr;
+        }
+        Writer.Reset();
+
+        UE_LOG(LogTemp, Log, TEXT("TimeRewindChecksum: %lld of %lld rewinds landed off their recorded state"), NumDiverged, NumVerified);
+        if (NumDroppedFrames > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TimeRewindChecksum: Dropped %lld frames, writer could not keep up"), NumDroppedFrames);
+        }
+    }
+
+    Super::Deinitialize();
+}
+
+void UTimeRewindChecksumSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Rewinds stop during actor ticks, a landing queued in an earlier frame has been through a physics step since
+    for (int32 Index = PendingLandings.Num() - 1; Index >= 0; --Index)
+    {
+        if (PendingLandings[Index].LandedFrame != GFrameCounter)
+        {
+            CheckLanding(PendingLandings[Index]);
+            PendingLandings.RemoveAtSwap(Index);
+        }
+    }
+}
+
+TStatId UTimeRewindChecksumSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTimeRewindChecksumSubsystem, STATGROUP_Tickables);
+}
+
+void UTimeRewindChecksumSubsystem::RecordState(const AActor* Actor, const FTimeState& State, double OldestTime)
+{
+    if (!Writer || !Actor)
+        return;
+
+    if (GFrameCounter != CurrentFrame)
+    {
+        FlushFrame();
+        CurrentFrame = GFrameCounter;
+    }
+    CurrentFrameTime = State.Timestamp;
+
+    FActorChecksums& Checksums = FindOrAddActor(Actor);
+    const uint64 Hash = HashState(State);
+    FrameRows.Add({ Checksums.ActorId, Hash });
+
+    // Same window as the actor's history, one state older than OldestTime stays
+    Checksums.Recorded.TrimBefore(OldestTime);
+
+    FRecordedState& Recorded = Checksums.Recorded.Append(State.Timestamp);
+    Recorded.RecordedTime = State.Timestamp;
+    Recorded.Frame = GetFrameIndex();
+    Recorded.Hash = Hash;
+    Recorded.Location = State.Transform.GetLocation();
+    Recorded.Rotation = FQuat4f(State.Transform.GetRotation());
+    Recorded.Velocity = FVector3f(State.Velocity);
+    Recorded.AngularVelocity = FVector3f(State.AngularVelocity);
+}
+
+void UTimeRewindChecksumSubsystem::VerifyLanding(UTimeRewindComponent* Component, double BranchTime)
+{
+    if (!Writer || !Component)
+        return;
+
+    const FActorChecksums* Checksums = Actors.Find(Component->GetOwner());
+    const FRecordedState* Expected = Checksums ? FindRecorded(*Checksums, BranchTime) : nullptr;
+    if (!Expected)
+        return;
+
+    PendingLandings.Add({ Component, *Expected, GFrameCounter, GetWorld()->GetTimeSeconds() });
+}
+
+void UTimeRewindChecksumSubsystem::BranchHistory(const AActor* Actor, double BranchTime, double Now)
+{
+    FActorChecksums* Checksums = Writer ? Actors.Find(Actor) : nullptr;
+    if (!Checksums)
+        return;
+
+    // The state at BranchTime may come back from its float offset just after it, keep it all the same
+    Checksums->Recorded.Branch(BranchTime + TimeMatchWindow, Now + TimeMatchWindow);
+}
+
+void UTimeRewindChecksumSubsystem::CheckLanding(const FPendingLanding& Landing)
+{
+    UTimeRewindComponent* Component = Landing.Component.Get();
+    const AActor* Actor = Component ? Component->GetOwner() : nullptr;
+    FActorChecksums* Checksums = Actor ? Actors.Find(Actor) : nullptr;
+    if (!Checksums)
+        return;
+
+    FTimeState Landed;
+    Component->CaptureState(Landed);
+
+    ++NumVerified;
+    const FRecordedState& Expected = Landing.Expected;
+    if (HashState(Landed) == Expected.Hash)
+        return;
+
+    // The actor has been moving on from the landing point since, allow for how far it could get
+    const double Elapsed = GetWorld()->GetTimeSeconds() - Landing.LandedTime;
+    double AllowedDistance = LocationTolerance + Expected.Velocity.Size() * Elapsed;
+    const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+    if (Primitive && Primitive->IsSimulatingPhysics())
+    {
+        AllowedDistance += 0.5 * FMath::Abs(GetWorld()->GetGravityZ()) * FMath::Square(Elapsed);
+    }
+    const double AllowedAngle = FMath::DegreesToRadians(AngleTolerance) + Expected.AngularVelocity.Size() * Elapsed;
+
+    const double Distance = FVector::Dist(Expected.Location, Landed.Transform.GetLocation());
+    const double Angle = FQuat(Expected.Rotation).AngularDistance(Landed.Transform.GetRotation());
+    if (Distance <= AllowedDistance && Angle <= AllowedAngle)
+        return;
+
+    ReportDivergence(*Checksums, Actor, Expected, FString::Printf(TEXT("landed %.3f units and %.2f degrees off (allowed %.3f and %.2f)"),
+        Distance, FMath::RadiansToDegrees(Angle), AllowedDistance, FMath::RadiansToDegrees(AllowedAngle)));
+}
+
+void UTimeRewindChecksumSubsystem::ReportDivergence(FActorChecksums& Checksums, const AActor* Actor, const FRecordedState& Expected, const FString& Details)
+{
+    ++NumDiverged;
+
+    // A diverging actor usually diverges on every rewind, report it now and then with how often it happened
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now - Checksums.LastReportTime < ReportInterval)
+    {
+        ++Checksums.NumSuppressedReports;
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("TimeRewindChecksum: %s %s from its state recorded at frame %u (%.3fs, hash %016llx); %d reports suppressed since the last one"),
+        *Actor->GetName(), *Details, Expected.Frame, Expected.RecordedTime, Expected.Hash, Checksums.NumSuppressedReports);
+    Checksums.LastReportTime = Now;
+    Checksums.NumSuppressedReports = 0;
+}
+
+const UTimeRewindChecksumSubsystem::FRecordedState* UTimeRewindChecksumSubsystem::FindRecorded(const FActorChecksums& Checksums, double Time) const
+{
+    const int32 Index = Checksums.Recorded.UpperBound(Time + TimeMatchWindow) - 1;
+    if (Index >= 0 && FMath::Abs(Checksums.Recorded.TimeAt(Index) - Time) <= TimeMatchWindow)
+    {
+        return &Checksums.Recorded.At(Index);
+    }
+    return nullptr;
+}
+
+uint64 UTimeRewindChecksumSubsystem::HashState(const FTimeState& State) const
+{
+    const FVector Location = State.Transform.GetLocation();
+    // q and -q are the same rotation
+    FQuat Rotation = State.Transform.GetRotation();
+    if (Rotation.W < 0.0)
+    {
+        Rotation *= -1.0;
+    }
+    const FVector Scale = State.Transform.GetScale3D();
+
+    // Fixed layout so the whole state goes through the hash in one pass
+    const int32 Quantized[17] = {
+        Quantize(Location.X, Quantum), Quantize(Location.Y, Quantum), Quantize(Location.Z, Quantum),
+        Quantize(Rotation.X, UnitQuantum), Quantize(Rotation.Y, UnitQuantum), Quantize(Rotation.Z, UnitQuantum), Quantize(Rotation.W, UnitQuantum),
+        Quantize(Scale.X, UnitQuantum), Quantize(Scale.Y, UnitQuantum), Quantize(Scale.Z, UnitQuantum),
+        Quantize(State.Velocity.X, Quantum), Quantize(State.Velocity.Y, Quantum), Quantize(State.Velocity.Z, Quantum),
+        Quantize(State.AngularVelocity.X, UnitQuantum), Quantize(State.AngularVelocity.Y, UnitQuantum), Quantize(State.AngularVelocity.Z, UnitQuantum),
+        State.MovementMode,
+    };
+    return FXxHash64::HashBuffer(Quantized, sizeof(Quantized)).Hash;
+}
+
+UTimeRewindChecksumSubsystem::FActorChecksums& UTimeRewindChecksumSubsystem::FindOrAddActor(const AActor* Actor)
+{
+    if (FActorChecksums* Checksums = Actors.Find(Actor))
+        return *Checksums;
+
+    // Names are stable between runs where unique ids are not
+    const FString Name = Actor->GetName();
+    FActorChecksums& Checksums = Actors.Add(Actor);
+    Checksums.ActorId = FCrc::StrCrc32(*Name);
+    PendingActors.Add({ Checksums.ActorId, Name });
+    return Checksums;
+}
+
+void UTimeRewindChecksumSubsystem::FlushFrame()
+{
+    if (FrameRows.Num() == 0)
+        return;
+
+    // Tick order is not guaranteed between runs, the row order must not depend on it
+    FrameRows.Sort([](const FChecksumRow& A, const FChecksumRow& B) { return A.ActorId < B.ActorId; });
+
+    // Rows are padded, hash a packed copy so padding bytes never reach the checksum
+    RowHashScratch.Reset();
+    for (const FChecksumRow& Row : FrameRows)
+    {
+        RowHashScratch.Add(Row.ActorId);
+        RowHashScratch.Add(Row.Hash);
+    }
+    const uint64 FrameHash = FXxHash64::HashBuffer(RowHashScratch.GetData(), RowHashScratch.Num() * sizeof(uint64)).Hash;
+
+    if (!CurrentBatch)
+    {
+        CurrentBatch = Writer->AcquireBatch();
+    }
+    if (!CurrentBatch)
+    {
+        // Actor records stay queued for the next frame that gets through
+        ++NumDroppedFrames;
+        FrameRows.Reset();
+        return;
+    }
+
+    FMemoryWriter Ar(CurrentBatch->Bytes, false, true);
+    for (FPendingActor& Pending : PendingActors)
+    {
+        FTCHARToUTF8 Utf8Name(*Pending.Name);
+        uint32 Length = Utf8Name.Length();
+        WriteRecordType(Ar, TimeRewindChecksum::ERecordType::Actor);
+        Ar << Pending.ActorId;
+        Ar << Length;
+        Ar.Serialize(const_cast<ANSICHAR*>(Utf8Name.Get()), Length);
+    }
+    PendingActors.Reset();
+    WriteFrame(Ar, FrameHash);
+    FrameRows.Reset();
+
+    if (CurrentBatch->ShouldSubmit())
+    {
+        Writer->SubmitBatch(CurrentBatch);
+        CurrentBatch = nullptr;
+    }
+}
+
+void UTimeRewindChecksumSubsystem::WriteFrame(FArchive& Ar, uint64 FrameHash)
+{
+    uint32 Frame = (uint32)(CurrentFrame - FirstFrame);
+    double Time = CurrentFrameTime;
+    uint32 NumRows = FrameRows.Num();
+
+    WriteRecordType(Ar, TimeRewindChecksum::ERecordType::Frame);
+    Ar << Frame;
+    Ar << Time;
+    Ar << FrameHash;
+    Ar << NumRows;
+    for (FChecksumRow& Row : FrameRows)
+    {
+        Ar << Row.ActorId;
+        Ar << Row.Hash;
+    }
+}
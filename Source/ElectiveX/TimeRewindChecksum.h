@@ -0,0 +1,179 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TimeRewindHistory.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+#include "TimeRewindChecksum.generated.h"
+
+struct FTimeState;
+class UTimeRewindComponent;
+
+/*
+ * Checksum stream layout (.trwc, little endian), compared offline by Tools/CompareRewindChecksums.cpp
+ *
+ * Header: "TRWC" magic, uint32 version
+ * Then records of: uint32 record type, followed by
+ *   Actor: uint32 ActorId, uint32 byte length + UTF-8 name
+ *   Frame: uint32 Frame, double Time, uint64 FrameHash, uint32 row count, then per row uint32 ActorId + uint64 StateHash
+ *
+ * Frames count from the world start and rows are sorted by ActorId, so two runs of the same input
+ * produce identical streams.
+ */
+namespace TimeRewindChecksum
+{
+    constexpr uint32 FileMagic = 0x43575254; // "TRWC"
+    constexpr uint32 FileVersion = 1;
+
+    enum class ERecordType : uint32
+    {
+        Actor = 1,
+        Frame = 2,
+    };
+}
+
+// Serialized records waiting for the writer thread
+struct FTimeRewindChecksumBatch
+{
+    static constexpr int32 MaxBytes = 64 * 1024;
+
+    TArray<uint8> Bytes;
+
+    FTimeRewindChecksumBatch() { Bytes.Reserve(MaxBytes); }
+
+    // Handed off at half capacity, so the next frame normally fits without growing the buffer
+    bool ShouldSubmit() const { return Bytes.Num() >= MaxBytes / 2; }
+};
+
+// Background thread that appends submitted batches to the checksum stream
+class FTimeRewindChecksumWriter : public FRunnable
+{
+public:
+    FTimeRewindChecksumWriter(const FString& InFilename, int32 NumBatches);
+    virtual ~FTimeRewindChecksumWriter() override;
+
+    // Game thread: returns nullptr when every batch is in flight
+    FTimeRewindChecksumBatch* AcquireBatch();
+    // Game thread: hands a filled batch to the writer thread
+    void SubmitBatch(FTimeRewindChecksumBatch* Batch);
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FString Filename;
+    TArray<TUniquePtr<FTimeRewindChecksumBatch>> Batches;
+    TCircularQueue<FTimeRewindChecksumBatch*> FreeBatches;
+    TCircularQueue<FTimeRewindChecksumBatch*> FilledBatches;
+
+    FEvent* WorkEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested { false };
+};
+
+// Hashes every recorded FTimeState into one checksum per actor and frame, and checks that a rewind
+// lands actors on the state they were recorded in. Enabled with rewind.Checksums 1.
+UCLASS()
+class ELECTIVEX_API UTimeRewindChecksumSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    bool IsEnabled() const { return Writer.IsValid(); }
+
+    // Adds the state to this frame's checksums and keeps it for landing checks until OldestTime passes
+    void RecordState(const AActor* Actor, const FTimeState& State, double OldestTime);
+
+    // Once the next physics step has run, compares where the component's actor stands with the state
+    // recorded at BranchTime, which must be the time of a recorded sample
+    void VerifyLanding(UTimeRewindComponent* Component, double BranchTime);
+
+    // Same as the component's history branch, keeps the recorded states up to BranchTime shifted to Now
+    void BranchHistory(const AActor* Actor, double BranchTime, double Now);
+
+    // Timestamps are left out, states are quantized so values that only differ by float noise match
+    uint64 HashState(const FTimeState& State) const;
+
+private:
+    struct FChecksumRow
+    {
+        uint32 ActorId;
+        uint64 Hash;
+    };
+
+    // A recorded state with where it sits in the stream. The history's time follows the actor's
+    // history through branches, RecordedTime is the time written with its frame.
+    struct FRecordedState
+    {
+        // Seconds after the base time of the chunk holding the state
+        float Time;
+        double RecordedTime;
+        uint32 Frame;
+        uint64 Hash;
+        FVector Location;
+        FQuat4f Rotation;
+        FVector3f Velocity;
+        FVector3f AngularVelocity;
+    };
+
+    struct FActorChecksums
+    {
+        uint32 ActorId = 0;
+        TimeRewindCore::TChunkedHistory<FRecordedState> Recorded;
+        double LastReportTime = -UE_BIG_NUMBER;
+        int32 NumSuppressedReports = 0;
+    };
+
+    struct FPendingActor
+    {
+        uint32 ActorId;
+        FString Name;
+    };
+
+    struct FPendingLanding
+    {
+        TWeakObjectPtr<UTimeRewindComponent> Component;
+        FRecordedState Expected;
+        uint64 LandedFrame;
+        double LandedTime;
+    };
+
+    FActorChecksums& FindOrAddActor(const AActor* Actor);
+    const FRecordedState* FindRecorded(const FActorChecksums& Checksums, double Time) const;
+    void CheckLanding(const FPendingLanding& Landing);
+    void ReportDivergence(FActorChecksums& Checksums, const AActor* Actor, const FRecordedState& Expected, const FString& Details);
+    void FlushFrame();
+    void WriteFrame(FArchive& Ar, uint64 FrameHash);
+    uint32 GetFrameIndex() const { return (uint32)(GFrameCounter - FirstFrame); }
+
+    TUniquePtr<FTimeRewindChecksumWriter> Writer;
+    FTimeRewindChecksumBatch* CurrentBatch = nullptr;
+    TMap<TObjectKey<AActor>, FActorChecksums> Actors;
+    TArray<FPendingLanding> PendingLandings;
+    // Written ahead of the next frame, so they stay queued while the writer is behind
+    TArray<FPendingActor> PendingActors;
+
+    // Rows recorded during the frame being collected, written once the next frame records
+    TArray<FChecksumRow> FrameRows;
+    // Packed copy of FrameRows for the frame hash, reused between frames
+    TArray<uint64> RowHashScratch;
+    uint64 CurrentFrame = 0;
+    double CurrentFrameTime = 0.0;
+    uint64 FirstFrame = 0;
+
+    float Quantum = 0.01f;
+    float LocationTolerance = 1.0f;
+    float AngleTolerance = 1.0f;
+    int64 NumVerified = 0;
+    int64 NumDiverged = 0;
+    int64 NumDroppedFrames = 0;
+};
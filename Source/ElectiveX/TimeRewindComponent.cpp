@@ -1,8 +1,32 @@
 #include "TimeRewindComponent.h"
+#include "TimeRewindChannels.h"
+#include "TimeRewindChecksum.h"
+#include "TimeRewindQuerySubsystem.h"
+#include "TimeRewindTelemetry.h"
 #include "GameFramework/Actor.h"
-#include "GameFramework/CharacterMovementComponent.h"
 
-float RewindHistoryDuration;
+namespace
+{
+    TUniquePtr<FTimeHistoryTrack> MakeTimeHistory(ETimeRewindLayout Layout, const FTimeRewindBinding& Binding)
+    {
+        switch (Layout)
+        {
+        case ETimeRewindLayout::Position:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel>>(Binding);
+        case ETimeRewindLayout::PositionRotation:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel, FRotationChannel>>(Binding);
+        case ETimeRewindLayout::LinearVelocity:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel, FRotationChannel, FLinearVelocityChannel>>(Binding);
+        case ETimeRewindLayout::AngularVelocity:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel, FRotationChannel, FLinearVelocityChannel, FAngularVelocityChannel>>(Binding);
+        case ETimeRewindLayout::MovementMode:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel, FRotationChannel, FLinearVelocityChannel, FMovementModeChannel>>(Binding);
+        case ETimeRewindLayout::Full:
+        default:
+            return MakeUnique<TTimeHistoryTrack<FPositionChannel, FRotationChannel, FScaleChannel, FLinearVelocityChannel, FAngularVelocityChannel, FMovementModeChannel>>(Binding);
+        }
+    }
+}
 
 UTimeRewindComponent::UTimeRewindComponent()
 {
@@ -10,10 +34,13 @@ UTimeRewindComponent::UTimeRewindComponent()
     
     RewindDuration = 4.0f;
     RewindHistoryDuration = 4.0f;
-    RecordInterval = 0.016f;
-    MaxHistoryStates = FMath::CeilToInt(RewindHistoryDuration / RecordInterval);
+    RecordInterval = 0.05f;
+    MaxHistoryDuration = 4.0f * RewindHistoryDuration;
+    MaxHistoryStates = FMath::CeilToInt(MaxHistoryDuration / RecordInterval) + 1;
 }
 
+UTimeRewindComponent::~UTimeRewindComponent() = default;
+
 void UTimeRewindComponent::BeginPlay()
 {
     Super::BeginPlay();
@@ -25,16 +52,47 @@ void UTimeRewindComponent::BeginPlay()
         return;
     }
 
-    TimeHistory.Reserve(MaxHistoryStates);
-    OriginalHistory.Reserve(MaxHistoryStates);
+    if (!Owner->GetRootComponent())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TimeRewindComponent: Owner has no root component to record"));
+        return;
+    }
+
+    TimeHistory = MakeTimeHistory(HistoryLayout, FTimeRewindBinding::Resolve(Owner));
+
+    UTimeRewindTelemetrySubsystem* TelemetrySubsystem = GetWorld()->GetSubsystem<UTimeRewindTelemetrySubsystem>();
+    if (TelemetrySubsystem && TelemetrySubsystem->IsEnabled())
+    {
+        Telemetry = TelemetrySubsystem;
+    }
+
+    UTimeRewindChecksumSubsystem* ChecksumSubsystem = GetWorld()->GetSubsystem<UTimeRewindChecksumSubsystem>();
+    if (ChecksumSubsystem && ChecksumSubsystem->IsEnabled())
+    {
+        Checksums = ChecksumSubsystem;
+    }
+
+    if (UTimeRewindQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UTimeRewindQuerySubsystem>())
+    {
+        QuerySubsystem->RegisterComponent(this);
+    }
+}
+
+void UTimeRewindComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UTimeRewindQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UTimeRewindQuerySubsystem>())
+    {
+        QuerySubsystem->UnregisterComponent(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void UTimeRewindComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    AActor* Owner = GetOwner();
-    if (!Owner)
+    if (!TimeHistory)
         return;
 
     if (!bIsRewinding)
@@ -45,107 +103,83 @@ void UTimeRewindComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
         {
             RecordState();
             RecordTimer = 0.0f;
-
-            while (TimeHistory.Num() > MaxHistoryStates)
-            {
-                TimeHistory.RemoveAt(0);
-            }
+            TimeHistory->TrimBefore(GetWorld()->GetTimeSeconds() - MaxHistoryDuration);
+            TimeHistory->Trim(MaxHistoryStates);
         }
     }
     else
     {
-        RewindProgress += DeltaTime / RewindDuration;
+        // The last step lands exactly on the end of the window, which is where the timeline branches
+        RewindProgress = FMath::Min(RewindProgress + DeltaTime / RewindDuration, 1.0f);
+
+        double targetTime = RewindStartTime - (RewindProgress * RewindHistoryDuration);
+        FTimeState TargetState;
         
-        if (RewindProgress >= 1.0f)
+        if (TimeHistory->ApplyAtTime(targetTime, TargetState))
         {
-            StopTimeRewind();
-            return;
+            bIsMoving = TargetState.bWasMoving;
         }
 
-        float targetTime = RewindStartTime - (RewindProgress * RewindHistoryDuration);
-        FTimeState* TargetState = FindStateAtTime(targetTime);
-        
-        if (TargetState)
+        if (RewindProgress >= 1.0f)
         {
-            InterpolateToState(*TargetState);
+            StopTimeRewind();
         }
     }
 }
 
-FTimeState* UTimeRewindComponent::FindStateAtTime(float TargetTime)
+bool UTimeRewindComponent::SampleStateAtTime(double TargetTime, FTimeState& OutState) const
 {
-    if (OriginalHistory.Num() == 0)
-        return nullptr;
-
-    for (int32 i = OriginalHistory.Num() - 1; i >= 0; --i)
-    {
-        if (OriginalHistory[i].Timestamp <= TargetTime)
-        {
-            return &OriginalHistory[i];
-        }
-    }
+    if (!TimeHistory)
+        return false;
 
-    return &OriginalHistory[0];
+    OutState.Transform = GetOwner()->GetActorTransform();
+    return TimeHistory->SampleAtTime(TargetTime, OutState);
 }
 
-void UTimeRewindComponent::RecordState()
+bool UTimeRewindComponent::CoversTime(double TargetTime) const
 {
-    AActor* Owner = GetOwner();
-    if (!Owner)
-        return;
-
-    FTimeState NewState;
-    NewState.Transform = Owner->GetActorTransform();
-
-
-    UCharacterMovementComponent* MovementComponent = Cast<UCharacterMovementComponent>(Owner->GetComponentByClass(UCharacterMovementComponent::StaticClass()));
-    if (MovementComponent)
-    {
-        NewState.Velocity = MovementComponent->Velocity;
-        UE_LOG(LogTemp, Log, TEXT("Velocity: %s, Size: %.2f"), *NewState.Velocity.ToString(), NewState.Velocity.Size());
-        NewState.bWasMoving = NewState.Velocity.Size() > 1.0f;
-        UE_LOG(LogTemp, Log, TEXT("bWasMoving: %s"), NewState.bWasMoving ? TEXT("true") : TEXT("false"));
-    }
-    else
-    {
-        NewState.bWasMoving = false;
-    }
-    
-    NewState.Timestamp = GetWorld()->GetTimeSeconds();
-    TimeHistory.Add(NewState);
+    double Oldest = 0.0;
+    double Newest = 0.0;
+    return TimeHistory && TimeHistory->GetTimeRange(Oldest, Newest)
+        && TargetTime >= Oldest && TargetTime <= Newest + RecordInterval;
 }
 
+bool UTimeRewindComponent::HasHistory() const
+{
+    return TimeHistory && TimeHistory->Num() > 0;
+}
 
-void UTimeRewindComponent::InterpolateToState(const FTimeState& TargetState)
+TUniquePtr<FTimeHistoryTrack> UTimeRewindComponent::SnapshotHistory() const
 {
-    AActor* Owner = GetOwner();
-    if (!Owner)
-        return;
+    return TimeHistory ? TimeHistory->Clone() : nullptr;
+}
 
-    FTransform CurrentTransform = Owner->GetActorTransform();
-    FTransform InterpolatedTransform = FTransform::Identity;
-    
-    float Alpha = FMath::SmoothStep(0.0f, 1.0f, RewindProgress);
-    InterpolatedTransform.Blend(CurrentTransform, TargetState.Transform, Alpha);
-    
-    Owner->SetActorTransform(InterpolatedTransform);
+void UTimeRewindComponent::RecordState()
+{
+    TimeHistory->Record(GetWorld()->GetTimeSeconds());
 
-    UPrimitiveComponent* PrimitiveComp = Cast<UPrimitiveComponent>(Owner->GetRootComponent());
-    if (PrimitiveComp && PrimitiveComp->IsSimulatingPhysics())
+    if (Telemetry || Checksums)
     {
-        FVector CurrentVelocity = PrimitiveComp->GetPhysicsLinearVelocity();
-        FVector InterpolatedVelocity = FMath::Lerp(CurrentVelocity, TargetState.Velocity, Alpha);
-        
-        PrimitiveComp->SetPhysicsLinearVelocity(InterpolatedVelocity);
+        FTimeState NewState;
+        NewState.Transform = GetOwner()->GetActorTransform();
+        TimeHistory->GetLatestState(NewState);
+        if (Telemetry)
+        {
+            Telemetry->RecordSample(GetOwner(), NewState);
+        }
+        if (Checksums)
+        {
+            Checksums->RecordState(GetOwner(), NewState, NewState.Timestamp - MaxHistoryDuration);
+        }
     }
+}
 
-    if (TargetState.bWasMoving)
-    {
-        bIsMoving = true;
-    }
-    else
+void UTimeRewindComponent::CaptureState(FTimeState& OutState) const
+{
+    OutState.Transform = GetOwner()->GetActorTransform();
+    if (TimeHistory)
     {
-        bIsMoving = false;
+        TimeHistory->CaptureState(OutState);
     }
 }
 
@@ -158,8 +192,10 @@ void UTimeRewindComponent::StartTimeRewind()
         RewindProgress = 0.0f;
         RewindStartTime = GetWorld()->GetTimeSeconds();
 
-        // Create a backup of the current history to use during rewind
-        OriginalHistory = TimeHistory;
+        if (Telemetry)
+        {
+            Telemetry->RecordEvent(GetOwner(), ETimeRewindTelemetryEvent::RewindStart, RewindStartTime);
+        }
     }
 }
 
@@ -167,15 +203,48 @@ void UTimeRewindComponent::StopTimeRewind()
 {
     if (bIsRewinding)
     {
+        // Land on the recorded sample nearest the stop point, so the kept history ends on a state the
+        // actor really had and checksum runs can verify the landing against it. Worked out before the
+        // broadcast so listeners branch their own histories at the same time.
+        const double RewindStopTime = GetWorld()->GetTimeSeconds();
+        LandingTime = RewindStartTime - (FMath::Min(RewindProgress, 1.0f) * RewindHistoryDuration);
+        FTimeState Landing;
+        Landing.Transform = GetOwner()->GetActorTransform();
+        const bool bHasLanding = TimeHistory && TimeHistory->GetNearestState(LandingTime, Landing);
+        if (bHasLanding)
+        {
+            LandingTime = Landing.Timestamp;
+        }
+
         OnRewindStop.Broadcast();
         bIsRewinding = false;
+
+        // Keep the past up to where the rewind landed, recording carries on from there on a new branch
+        if (TimeHistory)
+        {
+            if (bHasLanding)
+            {
+                TimeHistory->ApplyAtTime(LandingTime, Landing);
+                if (Checksums)
+                {
+                    Checksums->VerifyLanding(this, LandingTime);
+                }
+            }
+            TimeHistory->Branch(LandingTime, RewindStopTime);
+            if (Checksums)
+            {
+                Checksums->BranchHistory(GetOwner(), LandingTime, RewindStopTime);
+            }
+        }
         RewindProgress = 0.0f;
-        
-        // Clear the history and start fresh after a rewind
-        TimeHistory.Empty();
-        OriginalHistory.Empty();
-        
-        float RewindDurationn = GetWorld()->GetTimeSeconds() - RewindStartTime;
+        RecordTimer = 0.0f;
+
+        if (Telemetry)
+        {
+            Telemetry->RecordEvent(GetOwner(), ETimeRewindTelemetryEvent::RewindStop, RewindStopTime);
+        }
+
+        float RewindDurationn = RewindStopTime - RewindStartTime;
         UE_LOG(LogTemp, Log, TEXT("Rewind finished in %.2f seconds"), RewindDurationn);
     }
 }
\ No newline at end of file
@@ -2,25 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "TimeState.h"
 #include "TimeRewindComponent.generated.h"
 
-// Struct to store object state at a specific point in time
-USTRUCT(BlueprintType)
-struct FTimeState
-{
-    GENERATED_BODY()
-
-    UPROPERTY()
-    FTransform Transform;
+class FTimeHistoryTrack;
+class UTimeRewindChecksumSubsystem;
+class UTimeRewindTelemetrySubsystem;
 
-    UPROPERTY()
-    FVector Velocity;
-
-    UPROPERTY()
-    double Timestamp;
-    
-    UPROPERTY()
-    bool bWasMoving;
+// Which state channels are recorded, pick the smallest one the actor needs
+UENUM(BlueprintType)
+enum class ETimeRewindLayout : uint8
+{
+    Position UMETA(DisplayName = "Position"),
+    PositionRotation UMETA(DisplayName = "Position + Rotation"),
+    LinearVelocity UMETA(DisplayName = "Position + Rotation + Linear Velocity"),
+    AngularVelocity UMETA(DisplayName = "Position + Rotation + Linear and Angular Velocity"),
+    MovementMode UMETA(DisplayName = "Position + Rotation + Linear Velocity + Movement Mode"),
+    Full UMETA(DisplayName = "All Channels"),
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FRewindEvent);
@@ -32,25 +30,59 @@ class ELECTIVEX_API UTimeRewindComponent : public UActorComponent
 
 public:    
     UTimeRewindComponent();
+    virtual ~UTimeRewindComponent() override;
 
+    // Seconds of history kept; several rewind windows deep so a rewind lands with history left to rewind again
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
-    int32 MaxHistoryStates = 250; 
+    float MaxHistoryDuration = 16.0f;
 
+    // Upper bound on stored samples, MaxHistoryDuration normally trims first
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
-    float RecordInterval = 0.016f;
+    int32 MaxHistoryStates = 321; 
+
+    // Samples are reconstructed with Hermite splines during playback, so 10-20 Hz is enough
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    float RecordInterval = 0.05f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
     float RewindDuration = 4.0f;
 
+    // Seconds of history a full rewind plays back over RewindDuration
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    float RewindHistoryDuration = 4.0f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
     float RewindTransitionTime = 2.0f;
 
+    // Fixed once play begins
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Time Travel")
+    ETimeRewindLayout HistoryLayout = ETimeRewindLayout::Full;
+
     UFUNCTION(BlueprintCallable, Category = "Time Travel")
     void StartTimeRewind();
 
     UFUNCTION(BlueprintCallable, Category = "Time Travel")
     void StopTimeRewind();
 
+    // Reconstructs the state at TargetTime from the samples bracketing it
+    bool SampleStateAtTime(double TargetTime, FTimeState& OutState) const;
+
+    // False outside the recorded history, where SampleStateAtTime clamps to the nearest end. Times
+    // after the newest sample count as covered up to one RecordInterval, the next sample is due then.
+    bool CoversTime(double TargetTime) const;
+
+    bool IsRewinding() const { return bIsRewinding; }
+
+    // World time of the recorded state the last rewind landed on, already set when OnRewindStop fires
+    double GetLandingTime() const { return LandingTime; }
+    bool HasHistory() const;
+
+    // Read-only copy of the recorded history for replays, null before play begins
+    TUniquePtr<FTimeHistoryTrack> SnapshotHistory() const;
+
+    // The owner's current state through the recorded channels, the rest of the transform is the live one
+    void CaptureState(FTimeState& OutState) const;
+
     UPROPERTY(BlueprintAssignable, Category = "Time Rewind")
     FRewindEvent OnRewindStart;
 
@@ -62,19 +94,26 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-    FTimeState* FindStateAtTime(float TargetTime);
 
 private:
-    TArray<FTimeState> TimeHistory;
-    TArray<FTimeState> OriginalHistory;
+    TUniquePtr<FTimeHistoryTrack> TimeHistory;
 
     float RecordTimer = 0.0f;
     bool bIsRewinding = false;
     float RewindProgress = 0.0f;
 
     void RecordState();
-    void InterpolateToState(const FTimeState& TargetState);
 
     double RewindStartTime;
+    double LandingTime = 0.0;
+
+    // Only set while rewind.Telemetry is enabled
+    UPROPERTY()
+    UTimeRewindTelemetrySubsystem* Telemetry = nullptr;
+
+    // Only set while rewind.Checksums is enabled
+    UPROPERTY()
+    UTimeRewindChecksumSubsystem* Checksums = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "TimeRewindQuerySubsystem.h"
+#include "TimeRewindComponent.h"
+#include "GameFramework/Actor.h"
+
+void UTimeRewindQuerySubsystem::RegisterComponent(UTimeRewindComponent* Component)
+{
+    if (Component && Component->GetOwner())
+    {
+        Components.Add(Component->GetOwner(), Component);
+    }
+}
+
+void UTimeRewindQuerySubsystem::UnregisterComponent(UTimeRewindComponent* Component)
+{
+    if (Component && Component->GetOwner())
+    {
+        Components.Remove(Component->GetOwner());
+    }
+}
+
+bool UTimeRewindQuerySubsystem::QueryStateAgo(const AActor* Target, float SecondsAgo, FTimeState& OutState)
+{
+    const FTimeRewindQueryResult Result = Query(Target, SecondsAgo);
+    if (Result.bValid)
+    {
+        OutState = Result.State;
+    }
+    return Result.bValid;
+}
+
+void UTimeRewindQuerySubsystem::QueryStates(const TArray<FTimeRewindQuery>& Queries, TArray<FTimeRewindQueryResult>& OutResults)
+{
+    OutResults.Reset(Queries.Num());
+    for (const FTimeRewindQuery& Request : Queries)
+    {
+        OutResults.Add(Query(Request.Target, Request.SecondsAgo));
+    }
+}
+
+bool UTimeRewindQuerySubsystem::IsRewinding(const AActor* Target) const
+{
+    const UTimeRewindComponent* Component = FindComponent(Target);
+    return Component && Component->IsRewinding();
+}
+
+bool UTimeRewindQuerySubsystem::HasHistory(const AActor* Target) const
+{
+    const UTimeRewindComponent* Component = FindComponent(Target);
+    return Component && Component->HasHistory();
+}
+
+const UTimeRewindComponent* UTimeRewindQuerySubsystem::FindComponent(const AActor* Target) const
+{
+    const TWeakObjectPtr<UTimeRewindComponent>* Component = Target ? Components.Find(Target) : nullptr;
+    return Component ? Component->Get() : nullptr;
+}
+
+FTimeRewindQueryResult UTimeRewindQuerySubsystem::Query(const AActor* Target, float SecondsAgo)
+{
+    if (CachedFrame != GFrameCounter)
+    {
+        FrameCache.Reset();
+        CachedFrame = GFrameCounter;
+    }
+
+    const UTimeRewindComponent* Component = FindComponent(Target);
+    if (!Component)
+        return FTimeRewindQueryResult();
+
+    // Every query in the same step samples the same time, so the cached result does not depend on who asked first
+    const double TargetTime = GetWorld()->GetTimeSeconds() - SecondsAgo;
+    const int64 TimeStep = FMath::RoundToInt64(TargetTime / CacheResolution);
+    const TPair<TObjectKey<AActor>, int64> Key(Target, TimeStep);
+
+    if (const FTimeRewindQueryResult* Cached = FrameCache.Find(Key))
+        return *Cached;
+
+    FTimeRewindQueryResult& Result = FrameCache.Add(Key);
+    Result.bRewinding = Component->IsRewinding();
+    const double SampleTime = TimeStep * CacheResolution;
+    Result.bValid = Component->CoversTime(SampleTime) && Component->SampleStateAtTime(SampleTime, Result.State);
+    return Result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TimeState.h"
+#include "TimeRewindQuerySubsystem.generated.h"
+
+class UTimeRewindComponent;
+
+USTRUCT(BlueprintType)
+struct FTimeRewindQuery
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    TObjectPtr<AActor> Target = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Travel")
+    float SecondsAgo = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FTimeRewindQueryResult
+{
+    GENERATED_BODY()
+
+    // False when the target records no history or SecondsAgo falls outside what it has recorded
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    bool bValid = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    bool bRewinding = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    FTimeState State;
+};
+
+// Read-only access to the histories UTimeRewindComponent already records, so AI tasks and perception
+// can ask where an actor was instead of keeping their own position memory. Results are cached for the
+// current frame, agents asking about the same target and delay only pay for the first lookup.
+UCLASS()
+class ELECTIVEX_API UTimeRewindQuerySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Queries within this many seconds of each other share a cached result
+    float CacheResolution = 0.01f;
+
+    void RegisterComponent(UTimeRewindComponent* Component);
+    void UnregisterComponent(UTimeRewindComponent* Component);
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    bool QueryStateAgo(const AActor* Target, float SecondsAgo, FTimeState& OutState);
+
+    // Answers every query in order, OutResults matches Queries one to one
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    void QueryStates(const TArray<FTimeRewindQuery>& Queries, TArray<FTimeRewindQueryResult>& OutResults);
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    bool IsRewinding(const AActor* Target) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    bool HasHistory(const AActor* Target) const;
+
+private:
+    const UTimeRewindComponent* FindComponent(const AActor* Target) const;
+    FTimeRewindQueryResult Query(const AActor* Target, float SecondsAgo);
+
+    TMap<TObjectKey<AActor>, TWeakObjectPtr<UTimeRewindComponent>> Components;
+
+    // Keyed by target and target time in CacheResolution steps
+    TMap<TPair<TObjectKey<AActor>, int64>, FTimeRewindQueryResult> FrameCache;
+    uint64 CachedFrame = 0;
+};
@@ -0,0 +1,244 @@
+#include "TimeRewindReplaySubsystem.h"
+#include "TimeRewindChannels.h"
+#include "TimeRewindComponent.h"
+#include "Camera/CameraActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace
+{
+    // Degrees per second the replay camera circles the focus
+    constexpr float CameraOrbitSpeed = 20.0f;
+
+    template <typename TMeshComponent>
+    void CopyMaterials(const TMeshComponent* From, TMeshComponent* To)
+    {
+        for (int32 Index = 0; Index < From->GetNumMaterials(); ++Index)
+        {
+            To->SetMaterial(Index, From->GetMaterial(Index));
+        }
+    }
+}
+
+UTimeRewindReplaySubsystem::UTimeRewindReplaySubsystem() = default;
+
+UTimeRewindReplaySubsystem::~UTimeRewindReplaySubsystem() = default;
+
+void UTimeRewindReplaySubsystem::RequestReplay(AActor* FocusActor, APlayerController* InViewer)
+{
+    if (bIsPending || bIsReplaying || !FocusActor)
+        return;
+
+    UWorld* World = GetWorld();
+    PendingFocus = FocusActor;
+    Viewer = InViewer ? InViewer : World->GetFirstPlayerController();
+    CaptureTime = World->GetTimeSeconds() + CaptureDelay;
+    bIsPending = true;
+}
+
+void UTimeRewindReplaySubsystem::StopReplay()
+{
+    bIsPending = false;
+    if (!bIsReplaying)
+        return;
+
+    bIsReplaying = false;
+    APlayerController* PlayerController = Viewer.Get();
+
+    for (FTimeRewindReplayTrack& Track : Tracks)
+    {
+        if (AActor* Proxy = Track.Proxy.Get())
+        {
+            Proxy->Destroy();
+        }
+        if (PlayerController && Track.Source.IsValid())
+        {
+            PlayerController->HiddenActors.Remove(Track.Source.Get());
+        }
+    }
+    Tracks.Reset();
+    FocusTrack = INDEX_NONE;
+
+    if (PlayerController)
+    {
+        AActor* RestoredTarget = PreviousViewTarget.IsValid() ? PreviousViewTarget.Get() : PlayerController->GetPawn();
+        PlayerController->SetViewTargetWithBlend(RestoredTarget, CameraBlendTime);
+    }
+    if (ACameraActor* Camera = ReplayCamera.Get())
+    {
+        Camera->Destroy();
+    }
+    ReplayCamera.Reset();
+    PreviousViewTarget.Reset();
+}
+
+void UTimeRewindReplaySubsystem::Deinitialize()
+{
+    // Proxies and the camera go away with the world
+    Tracks.Reset();
+
+    Super::Deinitialize();
+}
+
+void UTimeRewindReplaySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (bIsPending && GetWorld()->GetTimeSeconds() >= CaptureTime)
+    {
+        StartReplay();
+    }
+
+    if (!bIsReplaying)
+        return;
+
+    ReplayTime += DeltaTime * PlaybackRate;
+    if (ReplayTime >= CaptureTime || !Viewer.IsValid())
+    {
+        StopReplay();
+        return;
+    }
+
+    for (FTimeRewindReplayTrack& Track : Tracks)
+    {
+        AActor* Proxy = Track.Proxy.Get();
+        if (!Proxy)
+            continue;
+
+        // Channels the layout does not record keep the pose the source had at capture
+        FTimeState State;
+        State.Transform = Track.BaseTransform;
+        if (Track.History->SampleAtTime(ReplayTime, State))
+        {
+            Proxy->SetActorTransform(Track.MeshOffset * State.Transform);
+        }
+    }
+
+    UpdateCamera(DeltaTime);
+}
+
+TStatId UTimeRewindReplaySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTimeRewindReplaySubsystem, STATGROUP_Tickables);
+}
+
+void UTimeRewindReplaySubsystem::StartReplay()
+{
+    bIsPending = false;
+
+    UWorld* World = GetWorld();
+    AActor* Focus = PendingFocus.Get();
+    APlayerController* PlayerController = Viewer.Get();
+    if (!Focus || !PlayerController)
+        return;
+
+    // Same selection as a rewind, tagged actors near the event
+    TArray<AActor*> RewindableActors;
+    UGameplayStatics::GetAllActorsWithTag(World, FName("Rewindable"), RewindableActors);
+
+    const FVector Origin = Focus->GetActorLocation();
+    for (AActor* Actor : RewindableActors)
+    {
+        if (!Actor || FVector::DistSquared(Actor->GetActorLocation(), Origin) > FMath::Square(ReplayRadius))
+            continue;
+
+        UTimeRewindComponent* RewindComponent = Actor->FindComponentByClass<UTimeRewindComponent>();
+        TUniquePtr<FTimeHistoryTrack> History = RewindComponent ? RewindComponent->SnapshotHistory() : nullptr;
+        if (!History || History->Num() == 0)
+            continue;
+
+        FTransform MeshOffset;
+        AActor* Proxy = SpawnProxy(Actor, MeshOffset);
+        if (!Proxy)
+            continue;
+
+        if (Actor == Focus)
+        {
+            FocusTrack = Tracks.Num();
+        }
+
+        FTimeRewindReplayTrack& Track = Tracks.AddDefaulted_GetRef();
+        Track.History = MoveTemp(History);
+        Track.Source = Actor;
+        Track.Proxy = Proxy;
+        Track.MeshOffset = MeshOffset;
+        Track.BaseTransform = Actor->GetActorTransform();
+    }
+
+    if (FocusTrack == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TimeRewindReplay: %s has no rewind history or static mesh to replay"), *Focus->GetName());
+        for (FTimeRewindReplayTrack& Track : Tracks)
+        {
+            Track.Proxy->Destroy();
+        }
+        Tracks.Reset();
+        return;
+    }
+
+    // Hiding only affects this viewer's rendering, the live actors carry on as they were
+    for (const FTimeRewindReplayTrack& Track : Tracks)
+    {
+        PlayerController->HiddenActors.AddUnique(Track.Source.Get());
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    ACameraActor* Camera = World->SpawnActor<ACameraActor>(ACameraActor::StaticClass(), Origin, FRotator::ZeroRotator, SpawnParams);
+    ReplayCamera = Camera;
+    PreviousViewTarget = PlayerController->GetViewTarget();
+    CameraOrbit = PlayerController->GetControlRotation().Yaw;
+
+    bIsReplaying = true;
+    ReplayTime = CaptureTime - ReplayDuration;
+
+    UpdateCamera(0.0f);
+    PlayerController->SetViewTargetWithBlend(Camera, CameraBlendTime);
+
+    UE_LOG(LogTemp, Log, TEXT("TimeRewindReplay: Replaying %d actors around %s"), Tracks.Num(), *Focus->GetName());
+}
+
+AActor* UTimeRewindReplaySubsystem::SpawnProxy(AActor* Source, FTransform& OutMeshOffset)
+{
+    UWorld* World = GetWorld();
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Histories hold no bone poses, a skeletal proxy would slide through the replay in its reference
+    // pose. Animated actors stay live and visible instead of being replayed.
+    if (Source->FindComponentByClass<USkeletalMeshComponent>())
+        return nullptr;
+
+    // Proxies only carry the mesh, no gameplay components, collision or physics
+    if (const UStaticMeshComponent* Mesh = Source->FindComponentByClass<UStaticMeshComponent>())
+    {
+        AStaticMeshActor* Proxy = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Mesh->GetComponentTransform(), SpawnParams);
+        Proxy->SetMobility(EComponentMobility::Movable);
+        Proxy->SetActorEnableCollision(false);
+        Proxy->GetStaticMeshComponent()->SetStaticMesh(Mesh->GetStaticMesh());
+        CopyMaterials(Mesh, Proxy->GetStaticMeshComponent());
+
+        OutMeshOffset = Mesh->GetComponentTransform().GetRelativeTransform(Source->GetActorTransform());
+        return Proxy;
+    }
+
+    return nullptr;
+}
+
+void UTimeRewindReplaySubsystem::UpdateCamera(float DeltaTime)
+{
+    ACameraActor* Camera = ReplayCamera.Get();
+    AActor* FocusProxy = Tracks.IsValidIndex(FocusTrack) ? Tracks[FocusTrack].Proxy.Get() : nullptr;
+    if (!Camera || !FocusProxy)
+        return;
+
+    CameraOrbit += DeltaTime * CameraOrbitSpeed;
+
+    const FVector Target = FocusProxy->GetActorLocation();
+    const FVector Location = Target + FRotator(0.0f, CameraOrbit, 0.0f).RotateVector(FVector(-CameraDistance, 0.0f, CameraHeight));
+    Camera->SetActorLocationAndRotation(Location, (Target - Location).Rotation());
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TimeRewindReplaySubsystem.generated.h"
+
+class ACameraActor;
+class APlayerController;
+class FTimeHistoryTrack;
+
+// One recorded actor played back through a proxy that only copies its mesh
+struct FTimeRewindReplayTrack
+{
+    TUniquePtr<FTimeHistoryTrack> History;
+    TWeakObjectPtr<AActor> Source;
+    TWeakObjectPtr<AActor> Proxy;
+    // Mesh placement relative to the source actor, the history stores the actor transform
+    FTransform MeshOffset;
+    // Stands in for channels the source's layout does not record
+    FTransform BaseTransform;
+};
+
+// Instant replay of the last seconds around an actor, e.g. a killcam. Plays snapshots of the rewind
+// histories through mesh-only proxies seen from a replay camera, so live actors keep simulating
+// untouched and are only hidden from the viewer while the replay runs. No demo stream is recorded.
+// Only static mesh actors get proxies, skeletal meshes would replay without their animation.
+UCLASS()
+class ELECTIVEX_API UTimeRewindReplaySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UTimeRewindReplaySubsystem();
+    virtual ~UTimeRewindReplaySubsystem() override;
+
+    // Seconds of history shown, at most what the rewind components keep
+    float ReplayDuration = 3.0f;
+
+    // Keeps recording this long after the request so the outcome of the event is in the replay
+    float CaptureDelay = 0.75f;
+
+    float PlaybackRate = 0.5f;
+
+    // Only tagged actors this close to the focus are replayed
+    float ReplayRadius = 5000.0f;
+
+    float CameraDistance = 600.0f;
+    float CameraHeight = 200.0f;
+    float CameraBlendTime = 0.25f;
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    void RequestReplay(AActor* FocusActor, APlayerController* Viewer);
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    void StopReplay();
+
+    UFUNCTION(BlueprintCallable, Category = "Time Travel")
+    bool IsReplaying() const { return bIsReplaying; }
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    void StartReplay();
+    AActor* SpawnProxy(AActor* Source, FTransform& OutMeshOffset);
+    void UpdateCamera(float DeltaTime);
+
+    TArray<FTimeRewindReplayTrack> Tracks;
+    // Index into Tracks of the actor the camera follows
+    int32 FocusTrack = INDEX_NONE;
+
+    TWeakObjectPtr<AActor> PendingFocus;
+    TWeakObjectPtr<APlayerController> Viewer;
+    TWeakObjectPtr<AActor> PreviousViewTarget;
+    TWeakObjectPtr<ACameraActor> ReplayCamera;
+
+    bool bIsPending = false;
+    bool bIsReplaying = false;
+    double CaptureTime = 0.0;
+    double ReplayTime = 0.0;
+    float CameraOrbit = 0.0f;
+};
@@ -0,0 +1,325 @@
+#include "TimeRewindTelemetry.h"
+#include "TimeState.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<bool> CVarRewindTelemetry(
+    TEXT("rewind.Telemetry"),
+    false,
+    TEXT("Export rewind samples and events to Saved/Telemetry when a world starts."));
+
+static TAutoConsoleVariable<float> CVarRewindTelemetryFlushInterval(
+    TEXT("rewind.Telemetry.FlushInterval"),
+    1.0f,
+    TEXT("Seconds between hand-offs of partially filled telemetry batches to the writer thread."));
+
+namespace
+{
+    constexpr int32 NumTelemetryBatches = 8;
+    constexpr int32 ExpectedActors = 1024;
+
+    template <typename T>
+    void WriteColumn(FArchive& Ar, const TArray<T>& Column)
+    {
+        Ar.Serialize(const_cast<T*>(Column.GetData()), Column.Num() * sizeof(T));
+    }
+
+    void WriteBlockHeader(FArchive& Ar, TimeRewindTelemetry::EBlockType Type, int32 NumRows)
+    {
+        uint32 TypeValue = (uint32)Type;
+        uint32 RowCount = (uint32)NumRows;
+        Ar << TypeValue;
+        Ar << RowCount;
+    }
+}
+
+FTimeRewindTelemetryBatch::FTimeRewindTelemetryBatch()
+{
+    SampleActorIds.Reserve(MaxRows);
+    SampleTimestamps.Reserve(MaxRows);
+    for (TArray<float>& Column : SampleFloats)
+    {
+        Column.Reserve(MaxRows);
+    }
+    SampleMoving.Reserve(MaxRows);
+
+    EventActorIds.Reserve(MaxRows);
+    EventTimestamps.Reserve(MaxRows);
+    EventTypes.Reserve(MaxRows);
+
+    ActorIds.Reserve(MaxRows);
+    ActorNames.Reserve(MaxRows);
+}
+
+void FTimeRewindTelemetryBatch::Reset()
+{
+    SampleActorIds.Reset();
+    SampleTimestamps.Reset();
+    for (TArray<float>& Column : SampleFloats)
+    {
+        Column.Reset();
+    }
+    SampleMoving.Reset();
+
+    EventActorIds.Reset();
+    EventTimestamps.Reset();
+    EventTypes.Reset();
+
+    ActorIds.Reset();
+    ActorNames.Reset();
+}
+
+FTimeRewindTelemetryWriter::FTimeRewindTelemetryWriter(const FString& InFilename, int32 NumBatches)
+    : Filename(InFilename)
+    , FreeBatches(NumBatches + 1)
+    , FilledBatches(NumBatches + 1)
+{
+    for (int32 Index = 0; Index < NumBatches; ++Index)
+    {
+        FTimeRewindTelemetryBatch* Batch = Batches.Add_GetRef(MakeUnique<FTimeRewindTelemetryBatch>()).Get();
+        FreeBatches.Enqueue(Batch);
+    }
+
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool();
+    Thread = FRunnableThread::Create(this, TEXT("RewindTelemetryWriter"), 0, TPri_BelowNormal);
+}
+
+FTimeRewindTelemetryWriter::~FTimeRewindTelemetryWriter()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    WorkEvent = nullptr;
+}
+
+FTimeRewindTelemetryBatch* FTimeRewindTelemetryWriter::AcquireBatch()
+{
+    FTimeRewindTelemetryBatch* Batch = nullptr;
+    FreeBatches.Dequeue(Batch);
+    return Batch;
+}
+
+void FTimeRewindTelemetryWriter::SubmitBatch(FTimeRewindTelemetryBatch* Batch)
+{
+    // Cannot fail, there are never more batches than queue slots
+    FilledBatches.Enqueue(Batch);
+    WorkEvent->Trigger();
+}
+
+void FTimeRewindTelemetryWriter::Stop()
+{
+    bStopRequested = true;
+    WorkEvent->Trigger();
+}
+
+uint32 FTimeRewindTelemetryWriter::Run()
+{
+    TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+    if (Ar)
+    {
+        uint32 Magic = TimeRewindTelemetry::FileMagic;
+        uint32 Version = TimeRewindTelemetry::FileVersion;
+        *Ar << Magic;
+        *Ar << Version;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TimeRewindTelemetry: Could not open %s, rows will be discarded"), *Filename);
+    }
+
+    for (;;)
+    {
+        // Read the flag before draining so nothing submitted ahead of Stop() is missed
+        const bool bStopping = bStopRequested;
+
+        FTimeRewindTelemetryBatch* Batch = nullptr;
+        while (FilledBatches.Dequeue(Batch))
+        {
+            if (Ar)
+            {
+                WriteBatch(*Ar, *Batch);
+            }
+            Batch->Reset();
+            FreeBatches.Enqueue(Batch);
+        }
+
+        if (bStopping)
+            break;
+
+        WorkEvent->Wait(100);
+    }
+
+    if (Ar)
+    {
+        Ar->Close();
+    }
+    return 0;
+}
+
+void FTimeRewindTelemetryWriter::WriteBatch(FArchive& Ar, const FTimeRewindTelemetryBatch& Batch)
+{
+    using namespace TimeRewindTelemetry;
+
+    if (Batch.ActorIds.Num() > 0)
+    {
+        WriteBlockHeader(Ar, EBlockType::Actors, Batch.ActorIds.Num());
+        WriteColumn(Ar, Batch.ActorIds);
+        for (const FName& Name : Batch.ActorNames)
+        {
+            FTCHARToUTF8 Utf8Name(*Name.ToString());
+            uint32 Length = Utf8Name.Length();
+            Ar << Length;
+            Ar.Serialize(const_cast<ANSICHAR*>(Utf8Name.Get()), Length);
+        }
+    }
+
+    if (Batch.SampleActorIds.Num() > 0)
+    {
+        WriteBlockHeader(Ar, EBlockType::Samples, Batch.SampleActorIds.Num());
+        WriteColumn(Ar, Batch.SampleActorIds);
+        WriteColumn(Ar, Batch.SampleTimestamps);
+        for (const TArray<float>& Column : Batch.SampleFloats)
+        {
+            WriteColumn(Ar, Column);
+        }
+        WriteColumn(Ar, Batch.SampleMoving);
+    }
+
+    if (Batch.EventActorIds.Num() > 0)
+    {
+        WriteBlockHeader(Ar, EBlockType::Events, Batch.EventActorIds.Num());
+        WriteColumn(Ar, Batch.EventActorIds);
+        WriteColumn(Ar, Batch.EventTimestamps);
+        WriteColumn(Ar, Batch.EventTypes);
+    }
+}
+
+bool UTimeRewindTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    // Editor preview and inactive worlds would each open a telemetry file of their own
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTimeRewindTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (!CVarRewindTelemetry.GetValueOnGameThread())
+        return;
+
+    ActorIds.Reserve(ExpectedActors);
+
+    const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"),
+        FString::Printf(TEXT("RewindTelemetry_%s.trwt"), *FDateTime::Now().ToString()));
+    Writer = MakeUnique<FTimeRewindTelemetryWriter>(Filename, NumTelemetryBatches);
+
+    UE_LOG(LogTemp, Log, TEXT("TimeRewindTelemetry: Writing to %s"), *Filename);
+}
+
+void UTimeRewindTelemetrySubsystem::Deinitialize()
+{
+    if (Writer)
+    {
+        if (CurrentBatch)
+        {
+            Writer->SubmitBatch(CurrentBatch);
+            CurrentBatch = nullptr;
+        }
+        Writer.Reset();
+
+        if (DroppedRows > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TimeRewindTelemetry: Dropped %lld rows, writer could not keep up"), DroppedRows);
+        }
+    }
+
+    Super::Deinitialize();
+}
+
+bool UTimeRewindTelemetrySubsystem::EnsureBatch()
+{
+    if (!CurrentBatch)
+    {
+        CurrentBatch = Writer->AcquireBatch();
+    }
+
+    if (!CurrentBatch)
+    {
+        ++DroppedRows;
+        return false;
+    }
+    return true;
+}
+
+uint32 UTimeRewindTelemetrySubsystem::RegisterActor(const AActor* Actor)
+{
+    if (const uint32* ActorId = ActorIds.Find(Actor))
+        return *ActorId;
+
+    const uint32 ActorId = NextActorId++;
+    ActorIds.Add(Actor, ActorId);
+    CurrentBatch->ActorIds.Add(ActorId);
+    CurrentBatch->ActorNames.Add(Actor->GetFName());
+    return ActorId;
+}
+
+void UTimeRewindTelemetrySubsystem::FlushIfNeeded(double Timestamp)
+{
+    if (CurrentBatch->IsFull() || Timestamp - LastFlushTime >= CVarRewindTelemetryFlushInterval.GetValueOnGameThread())
+    {
+        Writer->SubmitBatch(CurrentBatch);
+        CurrentBatch = nullptr;
+        LastFlushTime = Timestamp;
+    }
+}
+
+void UTimeRewindTelemetrySubsystem::RecordSample(const AActor* Actor, const FTimeState& State)
+{
+    if (!Writer || !Actor || !EnsureBatch())
+        return;
+
+    const uint32 ActorId = RegisterActor(Actor);
+
+    const FVector Location = State.Transform.GetLocation();
+    const FQuat Rotation = State.Transform.GetRotation();
+    TArray<float>* Columns = CurrentBatch->SampleFloats;
+    Columns[FTimeRewindTelemetryBatch::LocX].Add(Location.X);
+    Columns[FTimeRewindTelemetryBatch::LocY].Add(Location.Y);
+    Columns[FTimeRewindTelemetryBatch::LocZ].Add(Location.Z);
+    Columns[FTimeRewindTelemetryBatch::RotX].Add(Rotation.X);
+    Columns[FTimeRewindTelemetryBatch::RotY].Add(Rotation.Y);
+    Columns[FTimeRewindTelemetryBatch::RotZ].Add(Rotation.Z);
+    Columns[FTimeRewindTelemetryBatch::RotW].Add(Rotation.W);
+    Columns[FTimeRewindTelemetryBatch::VelX].Add(State.Velocity.X);
+    Columns[FTimeRewindTelemetryBatch::VelY].Add(State.Velocity.Y);
+    Columns[FTimeRewindTelemetryBatch::VelZ].Add(State.Velocity.Z);
+    CurrentBatch->SampleActorIds.Add(ActorId);
+    CurrentBatch->SampleTimestamps.Add(State.Timestamp);
+    CurrentBatch->SampleMoving.Add(State.bWasMoving ? 1 : 0);
+
+    FlushIfNeeded(State.Timestamp);
+}
+
+void UTimeRewindTelemetrySubsystem::RecordEvent(const AActor* Actor, ETimeRewindTelemetryEvent Event, double Timestamp)
+{
+    if (!Writer || !Actor || !EnsureBatch())
+        return;
+
+    const uint32 ActorId = RegisterActor(Actor);
+
+    CurrentBatch->EventActorIds.Add(ActorId);
+    CurrentBatch->EventTimestamps.Add(Timestamp);
+    CurrentBatch->EventTypes.Add((uint8)Event);
+
+    FlushIfNeeded(Timestamp);
+}
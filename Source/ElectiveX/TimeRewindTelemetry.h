@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+#include "TimeRewindTelemetry.generated.h"
+
+struct FTimeState;
+
+/*
+ * Telemetry file layout (.trwt, little endian), read offline by Tools/RewindTelemetryToCsv.cpp
+ *
+ * Header: "TRWT" magic, uint32 version
+ * Then blocks of: uint32 block type, uint32 row count, followed by one contiguous array per column
+ *   Actors:  uint32 ActorId, then per row uint32 byte length + UTF-8 name
+ *   Samples: uint32 ActorId, double Timestamp, float LocX/Y/Z, float RotX/Y/Z/W, float VelX/Y/Z, uint8 bWasMoving
+ *   Events:  uint32 ActorId, double Timestamp, uint8 ETimeRewindTelemetryEvent
+ */
+namespace TimeRewindTelemetry
+{
+    constexpr uint32 FileMagic = 0x54575254; // "TRWT"
+    constexpr uint32 FileVersion = 1;
+
+    enum class EBlockType : uint32
+    {
+        Actors = 1,
+        Samples = 2,
+        Events = 3,
+    };
+}
+
+enum class ETimeRewindTelemetryEvent : uint8
+{
+    RewindStart = 0,
+    RewindStop = 1,
+};
+
+// One batch of rows stored column by column; handed to the writer thread when full
+struct FTimeRewindTelemetryBatch
+{
+    static constexpr int32 MaxRows = 2048;
+
+    enum ESampleColumn { LocX, LocY, LocZ, RotX, RotY, RotZ, RotW, VelX, VelY, VelZ, NumFloatColumns };
+
+    TArray<uint32> SampleActorIds;
+    TArray<double> SampleTimestamps;
+    TArray<float> SampleFloats[NumFloatColumns];
+    TArray<uint8> SampleMoving;
+
+    TArray<uint32> EventActorIds;
+    TArray<double> EventTimestamps;
+    TArray<uint8> EventTypes;
+
+    TArray<uint32> ActorIds;
+    // Converted to text on the writer thread
+    TArray<FName> ActorNames;
+
+    FTimeRewindTelemetryBatch();
+
+    // Every column is reserved for MaxRows, a batch is handed off before any of them would grow
+    bool IsFull() const { return SampleActorIds.Num() >= MaxRows || EventActorIds.Num() >= MaxRows || ActorIds.Num() >= MaxRows; }
+    bool IsEmpty() const { return SampleActorIds.Num() == 0 && EventActorIds.Num() == 0 && ActorIds.Num() == 0; }
+    void Reset();
+};
+
+// Background thread that drains full batches into the telemetry file
+class FTimeRewindTelemetryWriter : public FRunnable
+{
+public:
+    FTimeRewindTelemetryWriter(const FString& InFilename, int32 NumBatches);
+    virtual ~FTimeRewindTelemetryWriter() override;
+
+    // Game thread: returns nullptr when every batch is in flight
+    FTimeRewindTelemetryBatch* AcquireBatch();
+    // Game thread: hands a filled batch to the writer thread
+    void SubmitBatch(FTimeRewindTelemetryBatch* Batch);
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    void WriteBatch(FArchive& Ar, const FTimeRewindTelemetryBatch& Batch);
+
+    FString Filename;
+    TArray<TUniquePtr<FTimeRewindTelemetryBatch>> Batches;
+    TCircularQueue<FTimeRewindTelemetryBatch*> FreeBatches;
+    TCircularQueue<FTimeRewindTelemetryBatch*> FilledBatches;
+
+    FEvent* WorkEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested { false };
+};
+
+// Collects rewind samples and events from the game thread without ever blocking it. Rows go into
+// preallocated batches; the only game thread allocations are actor id map growth past
+// ExpectedActors. Enabled with rewind.Telemetry 1; rows are dropped when the writer falls behind.
+UCLASS()
+class ELECTIVEX_API UTimeRewindTelemetrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    bool IsEnabled() const { return Writer.IsValid(); }
+
+    void RecordSample(const AActor* Actor, const FTimeState& State);
+    void RecordEvent(const AActor* Actor, ETimeRewindTelemetryEvent Event, double Timestamp);
+
+private:
+    bool EnsureBatch();
+    // Returns the actor's id in this session's file, registering it on first sight
+    uint32 RegisterActor(const AActor* Actor);
+    void FlushIfNeeded(double Timestamp);
+
+    TUniquePtr<FTimeRewindTelemetryWriter> Writer;
+    FTimeRewindTelemetryBatch* CurrentBatch = nullptr;
+    // Session ids instead of GetUniqueID, which is handed to a new object once an actor is collected
+    TMap<TObjectKey<AActor>, uint32> ActorIds;
+    uint32 NextActorId = 1;
+    double LastFlushTime = 0.0;
+    int64 DroppedRows = 0;
+};
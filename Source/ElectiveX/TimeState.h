@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimeState.generated.h"
+
+// Struct to store object state at a specific point in time
+USTRUCT(BlueprintType)
+struct FTimeState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    FTransform Transform;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    FVector Velocity = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    FVector AngularVelocity = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    double Timestamp = 0.0;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    bool bWasMoving = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Time Travel")
+    uint8 MovementMode = 0;
+};
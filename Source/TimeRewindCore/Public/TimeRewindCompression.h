@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace TimeRewindCore
+{
+    // Stores a unit quaternion (x, y, z, w) as 16 bits per component
+    inline void PackQuaternion(const float In[4], int16_t Out[4])
+    {
+        const float Length = std::sqrt(In[0] * In[0] + In[1] * In[1] + In[2] * In[2] + In[3] * In[3]);
+        const float Scale = Length > 1e-8f ? 32767.0f / Length : 0.0f;
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            Out[Index] = (int16_t)std::lround(In[Index] * Scale);
+        }
+    }
+
+    inline void UnpackQuaternion(const int16_t In[4], float Out[4])
+    {
+        const float X = In[0], Y = In[1], Z = In[2], W = In[3];
+        const float Length = std::sqrt(X * X + Y * Y + Z * Z + W * W);
+        if (Length <= 0.0f)
+        {
+            Out[0] = Out[1] = Out[2] = 0.0f;
+            Out[3] = 1.0f;
+            return;
+        }
+
+        Out[0] = X / Length;
+        Out[1] = Y / Length;
+        Out[2] = Z / Length;
+        Out[3] = W / Length;
+    }
+}
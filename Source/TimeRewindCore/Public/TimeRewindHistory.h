@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TimeRewindCore
+{
+    /*
+     * Timestamp-ordered sample history stored in fixed-size chunks shared between timeline branches.
+     * SampleType only needs a float Time member, which holds the offset from its chunk's base time.
+     *
+     * A chunk is only ever appended to, so every reader keeps a stable view of the samples it already
+     * saw and copying a history is a cheap read-only snapshot. Branching at a point in time shares the chunks
+     * before it as they are and copies the chunk holding the branch point only when something else
+     * still references it.
+     */
+    template <typename SampleType, int32_t ChunkCapacity = 32>
+    class TChunkedHistory
+    {
+    public:
+        struct FChunk
+        {
+            explicit FChunk(double InBaseTime)
+                : BaseTime(InBaseTime)
+            {
+                Samples.reserve(ChunkCapacity);
+            }
+
+            bool IsFull() const { return (int32_t)Samples.size() == ChunkCapacity; }
+
+            double BaseTime;
+            std::vector<SampleType> Samples;
+        };
+
+        // Neighbouring samples around a point in time, From and To bracket it
+        struct FBracket
+        {
+            int32_t Prev = 0;
+            int32_t From = 0;
+            int32_t To = 0;
+            int32_t Next = 0;
+            float Alpha = 0.0f;
+
+            // Outside the recorded range only the nearest sample applies
+            bool IsClamped() const { return From == To; }
+        };
+
+        // Adds a sample at Time, which must not be older than the newest sample; caller fills the rest
+        SampleType& Append(double Time)
+        {
+            if (Chunks.empty() || Chunks.back().Chunk->IsFull())
+            {
+                Chunks.push_back({ std::make_shared<FChunk>(Time), 0.0 });
+            }
+
+            const FChunkRef& Tail = Chunks.back();
+            SampleType& Sample = Tail.Chunk->Samples.emplace_back();
+            Sample.Time = (float)(Time - Tail.GetBaseTime());
+            ++NumSamples;
+            return Sample;
+        }
+
+        // Keeps only the newest MaxSamples, releasing chunks no longer referenced
+        void Trim(int32_t MaxSamples)
+        {
+            if (NumSamples <= MaxSamples)
+                return;
+
+            FirstIndex += NumSamples - MaxSamples;
+            NumSamples = MaxSamples;
+
+            const int32_t ExpiredChunks = FirstIndex / ChunkCapacity;
+            if (ExpiredChunks > 0)
+            {
+                Chunks.erase(Chunks.begin(), Chunks.begin() + ExpiredChunks);
+                FirstIndex -= ExpiredChunks * ChunkCapacity;
+            }
+        }
+
+        // Drops samples older than OldestTime, keeping the last one before it so OldestTime can still be sampled
+        void TrimBefore(double OldestTime)
+        {
+            const int32_t Expired = UpperBound(OldestTime) - 1;
+            if (Expired > 0)
+            {
+                Trim(NumSamples - Expired);
+            }
+        }
+
+        void Reset()
+        {
+            Chunks.clear();
+            FirstIndex = 0;
+            NumSamples = 0;
+        }
+
+        // Drops everything recorded after BranchTime and shifts the rest so BranchTime lines up with Now
+        void Branch(double BranchTime, double Now)
+        {
+            const int32_t KeptSamples = UpperBound(BranchTime);
+            if (KeptSamples == 0)
+            {
+                Reset();
+                return;
+            }
+
+            const int32_t KeptEnd = FirstIndex + KeptSamples;
+            const int32_t KeptChunks = (KeptEnd + ChunkCapacity - 1) / ChunkCapacity;
+            Chunks.resize(KeptChunks);
+
+            FChunkRef& Tail = Chunks.back();
+            const int32_t TailSamples = KeptEnd - (KeptChunks - 1) * ChunkCapacity;
+            if (TailSamples < (int32_t)Tail.Chunk->Samples.size())
+            {
+                if (Tail.Chunk.use_count() > 1)
+                {
+                    std::shared_ptr<FChunk> Copy = std::make_shared<FChunk>(Tail.Chunk->BaseTime);
+                    Copy->Samples.assign(Tail.Chunk->Samples.begin(), Tail.Chunk->Samples.begin() + TailSamples);
+                    Tail.Chunk = std::move(Copy);
+                }
+                else
+                {
+                    Tail.Chunk->Samples.resize(TailSamples);
+                }
+            }
+
+            const double TimeShift = Now - BranchTime;
+            for (FChunkRef& Ref : Chunks)
+            {
+                Ref.TimeShift += TimeShift;
+            }
+            NumSamples = KeptSamples;
+        }
+
+        int32_t Num() const { return NumSamples; }
+
+        const SampleType& At(int32_t Index) const
+        {
+            return ChunkAt(Index).Chunk->Samples[(FirstIndex + Index) % ChunkCapacity];
+        }
+
+        double TimeAt(int32_t Index) const
+        {
+            return ChunkAt(Index).GetBaseTime() + At(Index).Time;
+        }
+
+        // Number of samples recorded at or before Time
+        int32_t UpperBound(double Time) const
+        {
+            int32_t Low = 0;
+            int32_t High = NumSamples;
+            while (Low < High)
+            {
+                const int32_t Mid = Low + (High - Low) / 2;
+                if (TimeAt(Mid) <= Time)
+                {
+                    Low = Mid + 1;
+                }
+                else
+                {
+                    High = Mid;
+                }
+            }
+            return Low;
+        }
+
+        bool FindBracket(double Time, FBracket& Out) const
+        {
+            if (NumSamples == 0)
+                return false;
+
+            const int32_t Next = UpperBound(Time);
+            if (Next == 0 || Next == NumSamples)
+            {
+                const int32_t Nearest = Next == 0 ? 0 : NumSamples - 1;
+                Out = { Nearest, Nearest, Nearest, Nearest, 0.0f };
+                return true;
+            }
+
+            const double FromTime = TimeAt(Next - 1);
+            const double Span = TimeAt(Next) - FromTime;
+            Out.Prev = Next >= 2 ? Next - 2 : 0;
+            Out.From = Next - 1;
+            Out.To = Next;
+            Out.Next = Next + 1 < NumSamples ? Next + 1 : NumSamples - 1;
+            Out.Alpha = Span > 1e-8 ? (float)((Time - FromTime) / Span) : 0.0f;
+            return true;
+        }
+
+    private:
+        struct FChunkRef
+        {
+            std::shared_ptr<FChunk> Chunk;
+            // Added by branching, the shared chunk itself is never rewritten
+            double TimeShift = 0.0;
+
+            double GetBaseTime() const { return Chunk->BaseTime + TimeShift; }
+        };
+
+        const FChunkRef& ChunkAt(int32_t Index) const
+        {
+            return Chunks[(FirstIndex + Index) / ChunkCapacity];
+        }
+
+        std::vector<FChunkRef> Chunks;
+        // Index of the oldest kept sample inside the first chunk
+        int32_t FirstIndex = 0;
+        int32_t NumSamples = 0;
+    };
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace TimeRewindCore
+{
+    /*
+     * Interpolation used to reconstruct states between recorded samples, on plain arrays so it runs
+     * and can be tested without the engine. Vectors are Dim contiguous values, quaternions are
+     * (x, y, z, w) and expected to be unit length.
+     */
+
+    // Cubic Hermite at Alpha in [0, 1], tangents are already scaled by the segment span
+    template <typename T>
+    void CubicHermite(const T* P0, const T* T0, const T* P1, const T* T1, T Alpha, T* Out, int32_t Dim = 3)
+    {
+        const T A2 = Alpha * Alpha;
+        const T A3 = A2 * Alpha;
+        const T H00 = 2 * A3 - 3 * A2 + 1;
+        const T H10 = A3 - 2 * A2 + Alpha;
+        const T H01 = -2 * A3 + 3 * A2;
+        const T H11 = A3 - A2;
+        for (int32_t Index = 0; Index < Dim; ++Index)
+        {
+            Out[Index] = H00 * P0[Index] + H10 * T0[Index] + H01 * P1[Index] + H11 * T1[Index];
+        }
+    }
+
+    // Derivative of CubicHermite with respect to Alpha, divide by the span for a velocity
+    template <typename T>
+    void CubicHermiteDerivative(const T* P0, const T* T0, const T* P1, const T* T1, T Alpha, T* Out, int32_t Dim = 3)
+    {
+        const T A2 = Alpha * Alpha;
+        const T D00 = 6 * A2 - 6 * Alpha;
+        const T D10 = 3 * A2 - 4 * Alpha + 1;
+        const T D01 = -6 * A2 + 6 * Alpha;
+        const T D11 = 3 * A2 - 2 * Alpha;
+        for (int32_t Index = 0; Index < Dim; ++Index)
+        {
+            Out[Index] = D00 * P0[Index] + D10 * T0[Index] + D01 * P1[Index] + D11 * T1[Index];
+        }
+    }
+
+    // Catmull-Rom tangent from the samples either side of a point, Gap apart in time, scaled to Span
+    template <typename T>
+    void CatmullRomTangent(const T* Before, const T* After, T Gap, T Span, T* Out, int32_t Dim = 3)
+    {
+        const T Scale = Span / (Gap > T(1e-8) ? Gap : T(1e-8));
+        for (int32_t Index = 0; Index < Dim; ++Index)
+        {
+            Out[Index] = (After[Index] - Before[Index]) * Scale;
+        }
+    }
+
+    inline float QuatDot(const float A[4], const float B[4])
+    {
+        return A[0] * B[0] + A[1] * B[1] + A[2] * B[2] + A[3] * B[3];
+    }
+
+    inline void QuatNormalize(float Q[4])
+    {
+        const float Length = std::sqrt(QuatDot(Q, Q));
+        if (Length <= 1e-8f)
+        {
+            Q[0] = Q[1] = Q[2] = 0.0f;
+            Q[3] = 1.0f;
+            return;
+        }
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            Q[Index] /= Length;
+        }
+    }
+
+    // Flips Q into the hemisphere of Reference, both then describe the same rotation along the short arc
+    inline void EnforceShortestArc(float Q[4], const float Reference[4])
+    {
+        if (QuatDot(Q, Reference) < 0.0f)
+        {
+            for (int32_t Index = 0; Index < 4; ++Index)
+            {
+                Q[Index] = -Q[Index];
+            }
+        }
+    }
+
+    inline void QuatMultiply(const float A[4], const float B[4], float Out[4])
+    {
+        const float X = A[3] * B[0] + A[0] * B[3] + A[1] * B[2] - A[2] * B[1];
+        const float Y = A[3] * B[1] - A[0] * B[2] + A[1] * B[3] + A[2] * B[0];
+        const float Z = A[3] * B[2] + A[0] * B[1] - A[1] * B[0] + A[2] * B[3];
+        const float W = A[3] * B[3] - A[0] * B[0] - A[1] * B[1] - A[2] * B[2];
+        Out[0] = X;
+        Out[1] = Y;
+        Out[2] = Z;
+        Out[3] = W;
+    }
+
+    // Log of a unit quaternion, a pure quaternion (w = 0)
+    inline void QuatLog(const float Q[4], float Out[4])
+    {
+        const float SinHalf = std::sqrt(Q[0] * Q[0] + Q[1] * Q[1] + Q[2] * Q[2]);
+        const float Half = std::atan2(SinHalf, Q[3]);
+        const float Scale = SinHalf > 1e-6f ? Half / SinHalf : 1.0f;
+        Out[0] = Q[0] * Scale;
+        Out[1] = Q[1] * Scale;
+        Out[2] = Q[2] * Scale;
+        Out[3] = 0.0f;
+    }
+
+    // Exp of a pure quaternion, a unit quaternion
+    inline void QuatExp(const float Q[4], float Out[4])
+    {
+        const float Half = std::sqrt(Q[0] * Q[0] + Q[1] * Q[1] + Q[2] * Q[2]);
+        const float Scale = Half > 1e-6f ? std::sin(Half) / Half : 1.0f;
+        Out[0] = Q[0] * Scale;
+        Out[1] = Q[1] * Scale;
+        Out[2] = Q[2] * Scale;
+        Out[3] = std::cos(Half);
+    }
+
+    // Spherical interpolation along the arc the inputs describe, callers pick the hemisphere
+    inline void SlerpFullPath(const float A[4], const float B[4], float Alpha, float Out[4])
+    {
+        const float CosAngle = std::fmax(-1.0f, std::fmin(1.0f, QuatDot(A, B)));
+        const float Angle = std::acos(CosAngle);
+        float ScaleA = 1.0f - Alpha;
+        float ScaleB = Alpha;
+        if (Angle > 1e-4f)
+        {
+            const float InvSin = 1.0f / std::sin(Angle);
+            ScaleA = std::sin((1.0f - Alpha) * Angle) * InvSin;
+            ScaleB = std::sin(Alpha * Angle) * InvSin;
+        }
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            Out[Index] = ScaleA * A[Index] + ScaleB * B[Index];
+        }
+    }
+
+    // Squad control point at Cur from its neighbours, all in Cur's hemisphere
+    inline void SquadTangent(const float Prev[4], const float Cur[4], const float Next[4], float Out[4])
+    {
+        const float Inverse[4] = { -Cur[0], -Cur[1], -Cur[2], Cur[3] };
+        float ToNext[4], ToPrev[4], LogNext[4], LogPrev[4];
+        QuatMultiply(Inverse, Next, ToNext);
+        QuatMultiply(Inverse, Prev, ToPrev);
+        QuatLog(ToNext, LogNext);
+        QuatLog(ToPrev, LogPrev);
+
+        const float Sum[4] = {
+            -0.25f * (LogNext[0] + LogPrev[0]),
+            -0.25f * (LogNext[1] + LogPrev[1]),
+            -0.25f * (LogNext[2] + LogPrev[2]),
+            0.0f,
+        };
+        float Offset[4];
+        QuatExp(Sum, Offset);
+        QuatMultiply(Cur, Offset, Out);
+    }
+
+    // Squad between From and To, with tangents from the samples either side. Each neighbour is moved
+    // into the hemisphere of the one before it so no tangent takes the log of a near -1 rotation.
+    inline void Squad(const float Prev[4], const float From[4], const float To[4], const float Next[4], float Alpha, float Out[4])
+    {
+        float Q0[4] = { From[0], From[1], From[2], From[3] };
+        float QPrev[4] = { Prev[0], Prev[1], Prev[2], Prev[3] };
+        float Q1[4] = { To[0], To[1], To[2], To[3] };
+        float QNext[4] = { Next[0], Next[1], Next[2], Next[3] };
+        EnforceShortestArc(QPrev, Q0);
+        EnforceShortestArc(Q1, Q0);
+        EnforceShortestArc(QNext, Q1);
+
+        float T0[4], T1[4];
+        SquadTangent(QPrev, Q0, Q1, T0);
+        SquadTangent(Q0, Q1, QNext, T1);
+
+        float OnArc[4], OnTangents[4];
+        SlerpFullPath(Q0, Q1, Alpha, OnArc);
+        SlerpFullPath(T0, T1, Alpha, OnTangents);
+        SlerpFullPath(OnArc, OnTangents, 2.0f * Alpha * (1.0f - Alpha), Out);
+        QuatNormalize(Out);
+    }
+}
@@ -0,0 +1,13 @@
+using UnrealBuildTool;
+
+// Engine-independent history containers and algorithms. Headers only use the C++ standard
+// library so they also build outside the engine, see Tools/TimeRewindBench.cpp.
+public class TimeRewindCore : ModuleRules
+{
+	public TimeRewindCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
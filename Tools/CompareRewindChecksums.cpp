@@ -0,0 +1,185 @@
+// Compares two rewind checksum streams (.trwc) written with rewind.Checksums 1 and reports the
+// first frame and actor where the runs diverge. Standalone, no engine dependency:
+//
+//   g++ -std=c++17 -O2 -o CompareRewindChecksums Tools/CompareRewindChecksums.cpp
+//   ./CompareRewindChecksums Saved/Checksums/RunA.trwc Saved/Checksums/RunB.trwc
+//
+// Exits with 0 when the streams match, 1 when they diverge and 2 when a file cannot be read.
+// See TimeRewindChecksum.h for the file layout.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t FileMagic = 0x43575254; // "TRWC"
+    constexpr uint32_t FileVersion = 1;
+
+    enum RecordType : uint32_t
+    {
+        Actor = 1,
+        Frame = 2,
+    };
+
+    struct FRow
+    {
+        uint32_t ActorId;
+        uint64_t Hash;
+    };
+
+    struct FFrame
+    {
+        uint32_t Index = 0;
+        double Time = 0.0;
+        uint64_t Hash = 0;
+        std::vector<FRow> Rows;
+    };
+
+    template <typename T>
+    bool ReadValue(std::ifstream& In, T& Value)
+    {
+        return static_cast<bool>(In.read(reinterpret_cast<char*>(&Value), sizeof(T)));
+    }
+
+    // Streams frames one at a time so soak test runs never have to fit in memory
+    class FChecksumReader
+    {
+    public:
+        bool Open(const char* Path)
+        {
+            In.open(Path, std::ios::binary);
+            uint32_t Magic = 0, Version = 0;
+            if (!In || !ReadValue(In, Magic) || !ReadValue(In, Version) || Magic != FileMagic || Version != FileVersion)
+            {
+                std::fprintf(stderr, "%s is not a version %u checksum stream\n", Path, FileVersion);
+                return false;
+            }
+            return true;
+        }
+
+        bool Next(FFrame& Out)
+        {
+            uint32_t Type = 0;
+            while (ReadValue(In, Type))
+            {
+                if (Type == Actor)
+                {
+                    uint32_t Id = 0, Length = 0;
+                    if (!ReadValue(In, Id) || !ReadValue(In, Length))
+                        return false;
+
+                    std::string Name(Length, '\0');
+                    if (!In.read(&Name[0], Length))
+                        return false;
+                    Names[Id] = Name;
+                    continue;
+                }
+
+                uint32_t NumRows = 0;
+                if (Type != Frame || !ReadValue(In, Out.Index) || !ReadValue(In, Out.Time) || !ReadValue(In, Out.Hash) || !ReadValue(In, NumRows))
+                    return false;
+
+                Out.Rows.resize(NumRows);
+                for (FRow& Row : Out.Rows)
+                {
+                    if (!ReadValue(In, Row.ActorId) || !ReadValue(In, Row.Hash))
+                        return false;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        std::string NameOf(uint32_t Id) const
+        {
+            const auto Found = Names.find(Id);
+            return Found != Names.end() ? Found->second : "actor " + std::to_string(Id);
+        }
+
+    private:
+        std::ifstream In;
+        std::unordered_map<uint32_t, std::string> Names;
+    };
+
+    // Rows are sorted by ActorId, walk both sides together to find the first actor that differs
+    void ReportFrame(const FChecksumReader& ReaderA, const FFrame& A, const FChecksumReader& ReaderB, const FFrame& B)
+    {
+        std::printf("First divergence at frame %u (%.3fs / %.3fs)\n", A.Index, A.Time, B.Time);
+
+        size_t IndexA = 0, IndexB = 0;
+        while (IndexA < A.Rows.size() || IndexB < B.Rows.size())
+        {
+            const FRow* RowA = IndexA < A.Rows.size() ? &A.Rows[IndexA] : nullptr;
+            const FRow* RowB = IndexB < B.Rows.size() ? &B.Rows[IndexB] : nullptr;
+
+            if (RowA && (!RowB || RowA->ActorId < RowB->ActorId))
+            {
+                std::printf("  %s only recorded in the first run\n", ReaderA.NameOf(RowA->ActorId).c_str());
+                return;
+            }
+            if (RowB && (!RowA || RowB->ActorId < RowA->ActorId))
+            {
+                std::printf("  %s only recorded in the second run\n", ReaderB.NameOf(RowB->ActorId).c_str());
+                return;
+            }
+            if (RowA->Hash != RowB->Hash)
+            {
+                std::printf("  %s has a different state\n", ReaderA.NameOf(RowA->ActorId).c_str());
+                return;
+            }
+            ++IndexA;
+            ++IndexB;
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    if (Argc < 3)
+    {
+        std::fprintf(stderr, "Usage: %s <first.trwc> <second.trwc>\n", Argv[0]);
+        return 2;
+    }
+
+    FChecksumReader ReaderA, ReaderB;
+    if (!ReaderA.Open(Argv[1]) || !ReaderB.Open(Argv[2]))
+        return 2;
+
+    FFrame A, B;
+    uint64_t NumFrames = 0;
+    for (;;)
+    {
+        const bool bHasA = ReaderA.Next(A);
+        const bool bHasB = ReaderB.Next(B);
+        if (!bHasA || !bHasB)
+        {
+            if (bHasA != bHasB)
+            {
+                std::printf("Streams match for %llu frames, then the %s run ends\n", (unsigned long long)NumFrames, bHasA ? "second" : "first");
+                return 1;
+            }
+            break;
+        }
+
+        if (A.Index != B.Index)
+        {
+            std::printf("First divergence after frame %llu: frame %u recorded states in one run only\n",
+                (unsigned long long)NumFrames, A.Index < B.Index ? A.Index : B.Index);
+            return 1;
+        }
+
+        if (A.Hash != B.Hash)
+        {
+            ReportFrame(ReaderA, A, ReaderB, B);
+            return 1;
+        }
+        ++NumFrames;
+    }
+
+    std::printf("Streams match, %llu frames compared\n", (unsigned long long)NumFrames);
+    return 0;
+}
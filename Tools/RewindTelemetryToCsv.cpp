@@ -0,0 +1,192 @@
+// Converts a rewind telemetry file (.trwt) written by UTimeRewindTelemetrySubsystem into CSV.
+// Standalone, no engine dependency:
+//
+//   g++ -std=c++17 -O2 -o RewindTelemetryToCsv Tools/RewindTelemetryToCsv.cpp
+//   ./RewindTelemetryToCsv Saved/Telemetry/RewindTelemetry_<date>.trwt
+//
+// Writes <input>.samples.csv and <input>.events.csv next to the input file.
+// See TimeRewindTelemetry.h for the file layout.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t FileMagic = 0x54575254; // "TRWT"
+    constexpr uint32_t FileVersion = 1;
+
+    enum BlockType : uint32_t
+    {
+        Actors = 1,
+        Samples = 2,
+        Events = 3,
+    };
+
+    constexpr int NumFloatColumns = 10;
+    const char* EventNames[] = { "RewindStart", "RewindStop" };
+
+    template <typename T>
+    bool ReadValue(std::ifstream& In, T& Value)
+    {
+        return static_cast<bool>(In.read(reinterpret_cast<char*>(&Value), sizeof(T)));
+    }
+
+    template <typename T>
+    bool ReadColumn(std::ifstream& In, std::vector<T>& Column, uint32_t NumRows)
+    {
+        Column.resize(NumRows);
+        return static_cast<bool>(In.read(reinterpret_cast<char*>(Column.data()), sizeof(T) * NumRows));
+    }
+
+    const std::string& ActorName(const std::unordered_map<uint32_t, std::string>& Names, uint32_t ActorId)
+    {
+        static const std::string Unknown = "";
+        const auto It = Names.find(ActorId);
+        return It != Names.end() ? It->second : Unknown;
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    if (Argc != 2)
+    {
+        std::fprintf(stderr, "Usage: %s <telemetry.trwt>\n", Argv[0]);
+        return 1;
+    }
+
+    const std::string InputPath = Argv[1];
+    std::ifstream In(InputPath, std::ios::binary);
+    if (!In)
+    {
+        std::fprintf(stderr, "Could not open %s\n", InputPath.c_str());
+        return 1;
+    }
+
+    uint32_t Magic = 0;
+    uint32_t Version = 0;
+    if (!ReadValue(In, Magic) || !ReadValue(In, Version) || Magic != FileMagic)
+    {
+        std::fprintf(stderr, "%s is not a rewind telemetry file\n", InputPath.c_str());
+        return 1;
+    }
+    if (Version != FileVersion)
+    {
+        std::fprintf(stderr, "Unsupported telemetry version %u\n", Version);
+        return 1;
+    }
+
+    FILE* SamplesCsv = std::fopen((InputPath + ".samples.csv").c_str(), "w");
+    FILE* EventsCsv = std::fopen((InputPath + ".events.csv").c_str(), "w");
+    if (!SamplesCsv || !EventsCsv)
+    {
+        std::fprintf(stderr, "Could not create output files\n");
+        return 1;
+    }
+
+    std::fprintf(SamplesCsv, "ActorId,ActorName,Timestamp,LocX,LocY,LocZ,RotX,RotY,RotZ,RotW,VelX,VelY,VelZ,WasMoving\n");
+    std::fprintf(EventsCsv, "ActorId,ActorName,Timestamp,Event\n");
+
+    std::unordered_map<uint32_t, std::string> Names;
+    std::vector<uint32_t> ActorIds;
+    std::vector<double> Timestamps;
+    std::vector<float> Floats[NumFloatColumns];
+    std::vector<uint8_t> Bytes;
+    size_t NumSamples = 0;
+    size_t NumEvents = 0;
+    bool bTruncated = false;
+
+    uint32_t Type = 0;
+    uint32_t NumRows = 0;
+    while (ReadValue(In, Type))
+    {
+        if (!ReadValue(In, NumRows))
+        {
+            bTruncated = true;
+            break;
+        }
+
+        if (Type == Actors)
+        {
+            if (!ReadColumn(In, ActorIds, NumRows))
+            {
+                bTruncated = true;
+                break;
+            }
+            for (uint32_t Row = 0; Row < NumRows; ++Row)
+            {
+                uint32_t Length = 0;
+                std::string Name;
+                if (!ReadValue(In, Length))
+                {
+                    bTruncated = true;
+                    break;
+                }
+                Name.resize(Length);
+                if (!In.read(&Name[0], Length))
+                {
+                    bTruncated = true;
+                    break;
+                }
+                Names[ActorIds[Row]] = std::move(Name);
+            }
+        }
+        else if (Type == Samples)
+        {
+            bool bOk = ReadColumn(In, ActorIds, NumRows) && ReadColumn(In, Timestamps, NumRows);
+            for (std::vector<float>& Column : Floats)
+            {
+                bOk = bOk && ReadColumn(In, Column, NumRows);
+            }
+            if (!bOk || !ReadColumn(In, Bytes, NumRows))
+            {
+                bTruncated = true;
+                break;
+            }
+
+            for (uint32_t Row = 0; Row < NumRows; ++Row)
+            {
+                std::fprintf(SamplesCsv, "%u,%s,%.6f", ActorIds[Row], ActorName(Names, ActorIds[Row]).c_str(), Timestamps[Row]);
+                for (const std::vector<float>& Column : Floats)
+                {
+                    std::fprintf(SamplesCsv, ",%g", Column[Row]);
+                }
+                std::fprintf(SamplesCsv, ",%u\n", Bytes[Row]);
+            }
+            NumSamples += NumRows;
+        }
+        else if (Type == Events)
+        {
+            if (!ReadColumn(In, ActorIds, NumRows) || !ReadColumn(In, Timestamps, NumRows) || !ReadColumn(In, Bytes, NumRows))
+            {
+                bTruncated = true;
+                break;
+            }
+
+            for (uint32_t Row = 0; Row < NumRows; ++Row)
+            {
+                const char* EventName = Bytes[Row] < 2 ? EventNames[Bytes[Row]] : "Unknown";
+                std::fprintf(EventsCsv, "%u,%s,%.6f,%s\n", ActorIds[Row], ActorName(Names, ActorIds[Row]).c_str(), Timestamps[Row], EventName);
+            }
+            NumEvents += NumRows;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown block type %u, stopping\n", Type);
+            break;
+        }
+    }
+
+    std::fclose(SamplesCsv);
+    std::fclose(EventsCsv);
+
+    if (bTruncated)
+    {
+        std::fprintf(stderr, "Warning: file ends mid-block, the last block was skipped\n");
+    }
+    std::printf("%zu samples, %zu events, %zu actors\n", NumSamples, NumEvents, Names.size());
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Microbenchmarks for the engine independent rewind core in Source/TimeRewindCore. Built and run by
+//
+//   make -C Tools bench
+//   ./Tools/Binaries/TimeRewindBench [NumSamples]
+//
+// Correctness is covered by TimeRewindCoreTests, run it first when a number looks suspiciously fast.
+
+#include "TimeRewindCompression.h"
+#include "TimeRewindHistory.h"
+#include "TimeRewindInterpolation.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    // Same footprint as the component's full layout: position, rotation, scale, velocities, mode
+    struct FBenchSample
+    {
+        float Position[3];
+        float Rotation[4];
+        float Scale[3];
+        float LinearVelocity[3];
+        float AngularVelocity[3];
+        uint8_t MovementMode;
+        float Time;
+    };
+
+    using FBenchHistory = TimeRewindCore::TChunkedHistory<FBenchSample>;
+
+    constexpr double RecordInterval = 0.05;
+    constexpr int32_t MaxHistoryStates = 600;
+
+    template <typename FunctionType>
+    void Measure(const char* Name, int64_t NumOperations, FunctionType&& Function)
+    {
+        const auto Start = std::chrono::steady_clock::now();
+        Function();
+        const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+        std::printf("%-28s %12lld ops %10.2f ns/op\n", Name, (long long)NumOperations, Seconds * 1e9 / (double)NumOperations);
+    }
+
+    void FillHistory(FBenchHistory& History, int32_t NumSamples, double StartTime)
+    {
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            FBenchSample& Sample = History.Append(StartTime + Index * RecordInterval);
+            Sample.Position[0] = (float)Index;
+            History.Trim(MaxHistoryStates);
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    const int32_t NumSamples = Argc > 1 ? std::atoi(Argv[1]) : 1000000;
+
+    // Keeps the optimizer from dropping the measured work
+    volatile double Sink = 0.0;
+
+    FBenchHistory History;
+    Measure("Append + Trim", NumSamples, [&]
+    {
+        FillHistory(History, NumSamples, 0.0);
+    });
+
+    Measure("FindBracket", NumSamples, [&]
+    {
+        const double Oldest = History.TimeAt(0);
+        const double Range = History.TimeAt(History.Num() - 1) - Oldest;
+        FBenchHistory::FBracket Bracket;
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            History.FindBracket(Oldest + Range * ((Index * 7919) % 1000) / 1000.0, Bracket);
+            Sink = Sink + Bracket.Alpha;
+        }
+    });
+
+    // Every snapshot pins the chunks its branch would otherwise cut, which forces the copy on write path
+    const int32_t NumBranches = NumSamples / 100;
+    Measure("Snapshot + Branch", NumBranches, [&]
+    {
+        for (int32_t Index = 0; Index < NumBranches; ++Index)
+        {
+            const FBenchHistory Snapshot = History;
+            FBenchHistory Branched = History;
+            Branched.Branch(Branched.TimeAt(Branched.Num() / 2 + 1), Branched.TimeAt(Branched.Num() - 1));
+            Sink = Sink + Branched.Num() + Snapshot.Num();
+        }
+    });
+
+    Measure("Hermite position", NumSamples, [&]
+    {
+        double P0[3] = { 0.0, 0.0, 0.0 };
+        const double P1[3] = { 10.0, 5.0, 1.0 };
+        const double T0[3] = { 1.0, 0.0, 0.0 };
+        const double T1[3] = { 0.0, 1.0, 0.0 };
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            TimeRewindCore::CubicHermite(P0, T0, P1, T1, (Index % 1000) / 1000.0, P0);
+        }
+        Sink = Sink + P0[0];
+    });
+
+    Measure("Squad rotation", NumSamples, [&]
+    {
+        const float Prev[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        const float From[4] = { 0.0f, 0.0f, 0.258819f, 0.965926f };
+        const float To[4] = { 0.0f, 0.0f, 0.5f, 0.866025f };
+        const float Next[4] = { 0.0f, 0.0f, 0.707107f, 0.707107f };
+        float Out[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            TimeRewindCore::Squad(Prev, From, To, Next, (Index % 1000) / 1000.0f, Out);
+            Sink = Sink + Out[3];
+        }
+    });
+
+    Measure("Pack + Unpack quaternion", NumSamples, [&]
+    {
+        float Rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        int16_t Packed[4];
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            Rotation[2] = std::sin(Index * 0.001f);
+            Rotation[3] = std::cos(Index * 0.001f);
+            TimeRewindCore::PackQuaternion(Rotation, Packed);
+            TimeRewindCore::UnpackQuaternion(Packed, Rotation);
+        }
+        Sink = Sink + Rotation[0];
+    });
+
+    return 0;
+}
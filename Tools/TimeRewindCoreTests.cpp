@@ -0,0 +1,256 @@
+// Unit tests for the engine independent rewind core in Source/TimeRewindCore. Built and run by
+//
+//   make -C Tools test
+//
+// Exits with the number of failed checks, so 0 means everything passed.
+
+#include "TimeRewindCompression.h"
+#include "TimeRewindHistory.h"
+#include "TimeRewindInterpolation.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+    struct FTestSample
+    {
+        float Value;
+        float Time;
+    };
+
+    using FTestHistory = TimeRewindCore::TChunkedHistory<FTestSample, 8>;
+
+    constexpr double RecordInterval = 0.05;
+
+    int NumChecks = 0;
+    int NumFailures = 0;
+
+#define CHECK(Condition) Check((Condition), #Condition, __FILE__, __LINE__)
+
+    void Check(bool bCondition, const char* What, const char* File, int Line)
+    {
+        ++NumChecks;
+        if (!bCondition)
+        {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", File, Line, What);
+            ++NumFailures;
+        }
+    }
+
+    bool Near(double A, double B, double Tolerance = 1e-4)
+    {
+        return std::abs(A - B) <= Tolerance;
+    }
+
+    // Angle between two rotations in radians, either hemisphere
+    float AngleBetween(const float A[4], const float B[4])
+    {
+        const float Dot = std::fmin(1.0f, std::abs(TimeRewindCore::QuatDot(A, B)));
+        return 2.0f * std::acos(Dot);
+    }
+
+    void MakeYawQuat(float Degrees, float Out[4])
+    {
+        const float Half = Degrees * 3.14159265f / 360.0f;
+        Out[0] = 0.0f;
+        Out[1] = 0.0f;
+        Out[2] = std::sin(Half);
+        Out[3] = std::cos(Half);
+    }
+
+    FTestHistory MakeHistory(int32_t NumSamples, double StartTime = 0.0)
+    {
+        FTestHistory History;
+        for (int32_t Index = 0; Index < NumSamples; ++Index)
+        {
+            History.Append(StartTime + Index * RecordInterval).Value = (float)Index;
+        }
+        return History;
+    }
+
+    void TestAppendAndTrim()
+    {
+        FTestHistory History = MakeHistory(100);
+        CHECK(History.Num() == 100);
+        CHECK(Near(History.TimeAt(99), 99 * RecordInterval));
+
+        History.Trim(30);
+        CHECK(History.Num() == 30);
+        CHECK(History.At(0).Value == 70.0f);
+        CHECK(Near(History.TimeAt(0), 70 * RecordInterval));
+        CHECK(History.At(29).Value == 99.0f);
+    }
+
+    void TestTrimBeforeKeepsOneOlderSample()
+    {
+        FTestHistory History = MakeHistory(100);
+        const double OldestTime = 40.5 * RecordInterval;
+        History.TrimBefore(OldestTime);
+        CHECK(History.Num() == 60);
+        CHECK(History.At(0).Value == 40.0f);
+        CHECK(History.TimeAt(0) <= OldestTime && History.TimeAt(1) > OldestTime);
+
+        // Nothing older than the window, nothing to drop
+        History.TrimBefore(0.0);
+        CHECK(History.Num() == 60);
+    }
+
+    void TestFindBracket()
+    {
+        const FTestHistory History = MakeHistory(20);
+        FTestHistory::FBracket Bracket;
+
+        CHECK(History.FindBracket(5.25 * RecordInterval, Bracket));
+        CHECK(Bracket.Prev == 4 && Bracket.From == 5 && Bracket.To == 6 && Bracket.Next == 7);
+        CHECK(Near(Bracket.Alpha, 0.25));
+
+        CHECK(History.FindBracket(-1.0, Bracket) && Bracket.IsClamped() && Bracket.From == 0);
+        CHECK(History.FindBracket(100.0, Bracket) && Bracket.IsClamped() && Bracket.From == 19);
+
+        const FTestHistory Empty;
+        CHECK(!Empty.FindBracket(0.0, Bracket));
+    }
+
+    void TestBranchSharesChunks()
+    {
+        FTestHistory History = MakeHistory(40);
+        const FTestHistory Snapshot = History;
+
+        const double BranchTime = History.TimeAt(20);
+        const double Now = 10.0;
+        History.Branch(BranchTime, Now);
+        History.Append(Now + RecordInterval).Value = -1.0f;
+
+        CHECK(History.Num() == 22);
+        CHECK(Near(History.TimeAt(20), Now));
+        CHECK(History.At(21).Value == -1.0f);
+
+        // The snapshot keeps the timeline it was taken from
+        CHECK(Snapshot.Num() == 40);
+        CHECK(Snapshot.At(21).Value == 21.0f);
+        CHECK(Near(Snapshot.TimeAt(20), BranchTime));
+    }
+
+    void TestBranchBeforeFirstSampleResets()
+    {
+        FTestHistory History = MakeHistory(10, 5.0);
+        History.Branch(1.0, 20.0);
+        CHECK(History.Num() == 0);
+    }
+
+    void TestCubicHermite()
+    {
+        // Constant velocity: the spline is the straight line and its derivative the velocity
+        const double P0[3] = { 0.0, 0.0, 0.0 };
+        const double P1[3] = { 10.0, 0.0, 0.0 };
+        const double Tangent[3] = { 10.0, 0.0, 0.0 };
+        double Out[3];
+        double Derivative[3];
+
+        TimeRewindCore::CubicHermite(P0, Tangent, P1, Tangent, 0.0, Out);
+        CHECK(Near(Out[0], 0.0));
+        TimeRewindCore::CubicHermite(P0, Tangent, P1, Tangent, 1.0, Out);
+        CHECK(Near(Out[0], 10.0));
+        TimeRewindCore::CubicHermite(P0, Tangent, P1, Tangent, 0.3, Out);
+        CHECK(Near(Out[0], 3.0));
+        TimeRewindCore::CubicHermiteDerivative(P0, Tangent, P1, Tangent, 0.7, Derivative);
+        CHECK(Near(Derivative[0], 10.0));
+
+        // Zero tangents ease in and out around the midpoint
+        const double Zero[3] = { 0.0, 0.0, 0.0 };
+        TimeRewindCore::CubicHermite(P0, Zero, P1, Zero, 0.5, Out);
+        CHECK(Near(Out[0], 5.0));
+        TimeRewindCore::CubicHermite(P0, Zero, P1, Zero, 0.25, Out);
+        CHECK(Out[0] < 2.5);
+    }
+
+    void TestCatmullRomFollowsLinearMotion()
+    {
+        const float Points[4][3] = { { 0, 0, 0 }, { 1, 2, 3 }, { 2, 4, 6 }, { 3, 6, 9 } };
+        const float Span = 0.05f;
+        float T0[3], T1[3], Out[3];
+        TimeRewindCore::CatmullRomTangent(Points[0], Points[2], 2 * Span, Span, T0);
+        TimeRewindCore::CatmullRomTangent(Points[1], Points[3], 2 * Span, Span, T1);
+        TimeRewindCore::CubicHermite(Points[1], T0, Points[2], T1, 0.5f, Out);
+        CHECK(Near(Out[0], 1.5) && Near(Out[1], 3.0) && Near(Out[2], 4.5));
+    }
+
+    void TestSquadEndpoints()
+    {
+        float Prev[4], From[4], To[4], Next[4], Out[4];
+        MakeYawQuat(0.0f, Prev);
+        MakeYawQuat(30.0f, From);
+        MakeYawQuat(60.0f, To);
+        MakeYawQuat(90.0f, Next);
+
+        TimeRewindCore::Squad(Prev, From, To, Next, 0.0f, Out);
+        CHECK(AngleBetween(Out, From) < 1e-3f);
+        TimeRewindCore::Squad(Prev, From, To, Next, 1.0f, Out);
+        CHECK(AngleBetween(Out, To) < 1e-3f);
+
+        // Constant angular speed stays on the great arc
+        float Middle[4];
+        MakeYawQuat(45.0f, Middle);
+        TimeRewindCore::Squad(Prev, From, To, Next, 0.5f, Out);
+        CHECK(AngleBetween(Out, Middle) < 1e-3f);
+        CHECK(Near(TimeRewindCore::QuatDot(Out, Out), 1.0));
+    }
+
+    void TestSquadIgnoresNeighbourHemisphere()
+    {
+        float Prev[4], From[4], To[4], Next[4], Reference[4], Flipped[4];
+        MakeYawQuat(0.0f, Prev);
+        MakeYawQuat(30.0f, From);
+        MakeYawQuat(60.0f, To);
+        MakeYawQuat(90.0f, Next);
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            Flipped[Index] = -Prev[Index];
+        }
+
+        // -q is the same rotation, the result must not change (or whip) because of it
+        for (float Alpha = 0.0f; Alpha <= 1.0f; Alpha += 0.125f)
+        {
+            float Out[4];
+            TimeRewindCore::Squad(Prev, From, To, Next, Alpha, Reference);
+            TimeRewindCore::Squad(Flipped, From, To, Next, Alpha, Out);
+            CHECK(AngleBetween(Out, Reference) < 1e-3f);
+        }
+    }
+
+    void TestQuaternionPacking()
+    {
+        const float Rotation[4] = { 0.5f, -0.5f, 0.5f, 0.5f };
+        int16_t Packed[4];
+        float Unpacked[4];
+        TimeRewindCore::PackQuaternion(Rotation, Packed);
+        TimeRewindCore::UnpackQuaternion(Packed, Unpacked);
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            CHECK(Near(Unpacked[Index], Rotation[Index]));
+        }
+
+        const int16_t Zero[4] = { 0, 0, 0, 0 };
+        TimeRewindCore::UnpackQuaternion(Zero, Unpacked);
+        CHECK(Unpacked[3] == 1.0f);
+    }
+}
+
+int main()
+{
+    TestAppendAndTrim();
+    TestTrimBeforeKeepsOneOlderSample();
+    TestFindBracket();
+    TestBranchSharesChunks();
+    TestBranchBeforeFirstSampleResets();
+    TestCubicHermite();
+    TestCatmullRomFollowsLinearMotion();
+    TestSquadEndpoints();
+    TestSquadIgnoresNeighbourHemisphere();
+    TestQuaternionPacking();
+
+    std::printf("%d checks, %d failed\n", NumChecks, NumFailures);
+    return NumFailures;
+}